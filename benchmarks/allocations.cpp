@@ -0,0 +1,142 @@
+#include <bench/allocations.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// the replacements of the global allocation functions cannot be inline, they
+// live in this single translation unit
+
+namespace {
+using bench::detail::allocated_bytes;
+using bench::detail::allocations;
+
+void *counted_allocate(std::size_t size, std::size_t alignment) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(static_cast<int64_t>(size),
+                            std::memory_order_relaxed);
+  // malloc(0) may return null, which operator new must not
+  size = size == 0 ? 1 : size;
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+#ifdef _MSC_VER
+  return _aligned_malloc(size, alignment);
+#else
+  // aligned_alloc requires a multiple of the alignment
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment
+                                         * alignment);
+#endif
+}
+
+// gcc flags the free() of memory from operator new once these are inlined,
+// which is precisely what the replacements pair up
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void counted_deallocate(void *p, std::size_t alignment) noexcept {
+#ifdef _MSC_VER
+  if (alignment > alignof(std::max_align_t)) {
+    _aligned_free(p);
+    return;
+  }
+#else
+  (void)alignment;
+#endif
+  std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+} // namespace
+
+void *operator new(std::size_t size) {
+  if (void *p = counted_allocate(size, 0)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  if (void *p =
+        counted_allocate(size, static_cast<std::size_t>(alignment))) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return counted_allocate(size, 0);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return counted_allocate(size, 0);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *p) noexcept {
+  counted_deallocate(p, 0);
+}
+
+void operator delete[](void *p) noexcept {
+  counted_deallocate(p, 0);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  counted_deallocate(p, 0);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+  counted_deallocate(p, 0);
+}
+
+void operator delete(void *p, std::align_val_t alignment) noexcept {
+  counted_deallocate(p, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *p, std::align_val_t alignment) noexcept {
+  counted_deallocate(p, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *p, std::size_t,
+                     std::align_val_t alignment) noexcept {
+  counted_deallocate(p, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *p, std::size_t,
+                       std::align_val_t alignment) noexcept {
+  counted_deallocate(p, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  counted_deallocate(p, 0);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  counted_deallocate(p, 0);
+}
+
+void operator delete(void *p, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  counted_deallocate(p, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *p, std::align_val_t alignment,
+                       const std::nothrow_t &) noexcept {
+  counted_deallocate(p, static_cast<std::size_t>(alignment));
+}
@@ -0,0 +1,79 @@
+#include <bench/consume.hpp>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/view/c_str.hpp>
+#include <string>
+#include <utility/c_str.hpp>
+#include <utility/to_container.hpp>
+
+// a null terminated string of `size` printable characters
+static std::string make_text(int64_t size) {
+  std::string text(static_cast<size_t>(size), ' ');
+  for (size_t index = 0; index != text.size(); ++index) {
+    text[index] = static_cast<char>(' ' + index % 95);
+  }
+  return text;
+}
+
+// each element is compared with the terminator while iterating
+static void distance_ranges_c_str(benchmark::State &state) {
+  const auto text  = make_text(state.range(0));
+  const char *data = text.c_str();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(data);
+    bench::do_not_optimize(ranges::distance(ranges::views::c_str(data)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(distance_ranges_c_str)->Range(1 << 4, 1 << 24);
+
+static void std_strlen(benchmark::State &state) {
+  const auto text  = make_text(state.range(0));
+  const char *data = text.c_str();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(data);
+    bench::do_not_optimize(std::strlen(data));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(std_strlen)->Range(1 << 4, 1 << 24);
+
+static void distance_utility_c_str(benchmark::State &state) {
+  const auto text  = make_text(state.range(0));
+  const char *data = text.c_str();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(data);
+    bench::do_not_optimize(ranges::distance(utility::views::c_str(data)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(distance_utility_c_str)->Range(1 << 4, 1 << 24);
+
+// unsized, the string grows as characters are pushed back
+static void to_string_ranges_c_str(benchmark::State &state) {
+  const auto text  = make_text(state.range(0));
+  const char *data = text.c_str();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(data);
+    bench::do_not_optimize(
+      utility::to<std::string>(ranges::views::c_str(data)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(to_string_ranges_c_str)->Range(1 << 4, 1 << 24);
+
+// sized and contiguous, the string is reserved and copied with memcpy
+static void to_string_utility_c_str(benchmark::State &state) {
+  const auto text  = make_text(state.range(0));
+  const char *data = text.c_str();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(data);
+    bench::do_not_optimize(
+      utility::to<std::string>(utility::views::c_str(data)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(to_string_utility_c_str)->Range(1 << 4, 1 << 24);
+
+BENCHMARK_MAIN();
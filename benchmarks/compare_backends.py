@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""Prints a side by side comparison of the same benchmarks built against
+different ranges backends.
+
+Reads the <benchmark>.<backend>.json files written by google benchmark with
+--benchmark_out_format=json and shows, for every benchmark, its real time on
+each backend relative to the baseline backend.
+"""
+
+import argparse
+import collections
+import json
+import pathlib
+import sys
+
+TIME_UNITS = {'ns': 1, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def load(directory):
+    """Returns {(executable, benchmark): {backend: nanoseconds}}"""
+    results = collections.defaultdict(dict)
+    backends = []
+    for path in sorted(pathlib.Path(directory).glob('*.json')):
+        executable, _, backend = path.stem.rpartition('.')
+        if not executable:
+            continue
+        with open(path) as file:
+            runs = json.load(file)['benchmarks']
+        # with repetitions, only compare means
+        if any(run.get('aggregate_name') == 'mean' for run in runs):
+            runs = [run for run in runs if run.get('aggregate_name') == 'mean']
+        for run in runs:
+            name = run.get('run_name', run['name'])
+            results[(executable, name)][backend] = (
+                run['real_time'] * TIME_UNITS[run.get('time_unit', 'ns')])
+        if backend not in backends:
+            backends.append(backend)
+    return results, backends
+
+
+def format_time(nanoseconds):
+    for unit in ('s', 'ms', 'us'):
+        if nanoseconds >= TIME_UNITS[unit]:
+            return '{:.3g}{}'.format(nanoseconds / TIME_UNITS[unit], unit)
+    return '{:.3g}ns'.format(nanoseconds)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('directory', help='directory of the json results')
+    parser.add_argument('--baseline', default='range_v3',
+                        help='backend the others are compared to')
+    args = parser.parse_args()
+
+    results, backends = load(args.directory)
+    if not results:
+        sys.exit('no results in ' + args.directory)
+    if args.baseline in backends:
+        backends.remove(args.baseline)
+        backends.insert(0, args.baseline)
+
+    header = ['benchmark'] + backends
+    rows = []
+    for (executable, name), times in results.items():
+        baseline = times.get(args.baseline)
+        row = [executable + '/' + name]
+        for backend in backends:
+            if backend not in times:
+                row.append('-')
+            elif baseline and backend != args.baseline:
+                row.append('{} ({:.2f}x)'.format(format_time(times[backend]),
+                                                 times[backend] / baseline))
+            else:
+                row.append(format_time(times[backend]))
+        rows.append(row)
+
+    widths = [max(len(row[column]) for row in [header] + rows)
+              for column in range(len(header))]
+    for row in [header] + rows:
+        print('  '.join(cell.ljust(width) for cell, width in zip(row, widths)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Compiles every generated pipeline translation unit again and prints its
+compile time and object size, for each backend.
+
+The compile commands come from the compile_commands.json written by CMake.
+Objects are written to a temporary directory, leaving the build untouched.
+"""
+
+import argparse
+import collections
+import json
+import os
+import pathlib
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def arguments(entry):
+    if 'arguments' in entry:
+        return list(entry['arguments'])
+    return shlex.split(entry['command'])
+
+
+def redirect_output(args, output):
+    result = []
+    skip = False
+    for arg in args:
+        if skip:
+            skip = False
+        elif arg == '-o':
+            skip = True
+        elif not arg.startswith('/Fo'):
+            result.append(arg)
+    is_msvc = pathlib.Path(args[0]).stem.lower() in ('cl', 'clang-cl')
+    return result + (['/Fo' + output] if is_msvc else ['-o', output])
+
+
+def measure(entry, output, repetitions, time_trace):
+    args = redirect_output(arguments(entry), output)
+    if time_trace:
+        args.append('-ftime-trace')
+    best = None
+    for _ in range(repetitions):
+        start = time.perf_counter()
+        subprocess.run(args, cwd=entry['directory'], check=True,
+                       stdout=subprocess.DEVNULL)
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best, os.path.getsize(output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--compile-commands', required=True)
+    parser.add_argument('--sources', required=True,
+                        help='directory of the generated <backend>/<shape>.cpp')
+    parser.add_argument('--repetitions', type=int, default=3,
+                        help='the fastest of the repetitions is reported')
+    parser.add_argument('--time-trace', action='store_true',
+                        help='keep a -ftime-trace json next to each source')
+    args = parser.parse_args()
+
+    sources = pathlib.Path(args.sources).resolve()
+    with open(args.compile_commands) as file:
+        entries = [entry for entry in json.load(file)
+                   if sources in pathlib.Path(entry['directory'],
+                                              entry['file']).resolve().parents]
+    if not entries:
+        sys.exit('no generated translation units in ' + args.compile_commands)
+
+    # {shape: {backend: (seconds, bytes)}}
+    results = collections.defaultdict(dict)
+    backends = []
+    with tempfile.TemporaryDirectory() as output_dir:
+        for entry in entries:
+            source = pathlib.Path(entry['directory'], entry['file']).resolve()
+            backend, shape = source.parent.name, source.stem
+            if shape == 'main':
+                continue
+            output = str(pathlib.Path(output_dir, backend + '_' + shape + '.o'))
+            print('compiling', backend, shape, file=sys.stderr)
+            results[shape][backend] = measure(entry, output, args.repetitions,
+                                              args.time_trace)
+            if args.time_trace:
+                # clang writes the trace next to the object
+                trace = pathlib.Path(output).with_suffix('.json')
+                shutil.copyfile(trace, source.with_suffix('.json'))
+            if backend not in backends:
+                backends.append(backend)
+
+    header = ['pipeline'] + backends
+    rows = []
+    for shape, by_backend in results.items():
+        row = [shape]
+        for backend in backends:
+            if backend in by_backend:
+                seconds, size = by_backend[backend]
+                row.append('{:.2f}s {:.0f}KiB'.format(seconds, size / 1024))
+            else:
+                row.append('-')
+        rows.append(row)
+
+    widths = [max(len(row[column]) for row in [header] + rows)
+              for column in range(len(header))]
+    for row in [header] + rows:
+        print('  '.join(cell.ljust(width) for cell, width in zip(row, widths)))
+
+
+if __name__ == '__main__':
+    main()
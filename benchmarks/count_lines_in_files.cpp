@@ -1,9 +1,27 @@
 #include <benchmark/benchmark.h>
 #include <range/v3/algorithm/count.hpp>
+#include <range/v3/algorithm/count_if.hpp>
+#include <range/v3/algorithm/max.hpp>
+#include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/join.hpp>
 #include <range/v3/view/transform.hpp>
-#include <range/v3/view/single.hpp>
+#include <atomic>
+#include <bench/consume.hpp>
+#include <bench/corpus.hpp>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <utility/file_chunks.hpp>
+#include <utility/lines.hpp>
+#include <utility/mapped_file.hpp>
+#include <utility/read_ahead.hpp>
+#include <utility/simd.hpp>
+#include <utility/text_stats.hpp>
+#include <utility/thread_pool.hpp>
+
+using bench::corpus_fixture;
 
 template <typename Rng> auto CPP_fun(count_lines_in_files)(Rng &&files)(
   requires ranges::range<Rng>) {
@@ -21,15 +39,18 @@ template <typename Rng> auto CPP_fun(count_lines_in_files)(Rng &&files)(
          | ranges::views::transform(count_lines);
 }
 
-static void rangify(benchmark::State &state) {
+BENCHMARK_DEFINE_F(corpus_fixture, rangify)(benchmark::State &state) {
   for (auto _ : state) {
-    auto lines =
-      count_lines_in_files(ranges::views::single(std::string{__FILE__}));
-    // Make sure the variable is not optimized away by compiler
-    benchmark::DoNotOptimize(lines);
+    prepare(state);
+    auto lines = count_lines_in_files(files());
+    // Read every count, otherwise a lazy pipeline never opens a file
+    bench::consume(lines);
   }
+  check_lines(state, count_lines_in_files(files()));
+  report(state);
 }
-BENCHMARK(rangify)->Range(8, 8 << 11);
+BENCHMARK_REGISTER_F(corpus_fixture, rangify)
+  ->Apply(corpus_fixture::arguments);
 
 template <typename Rng> auto CPP_fun(count_lines_in_files_2)(Rng &&files)(
   requires ranges::range<Rng>) {
@@ -53,14 +74,301 @@ template <typename Rng> auto CPP_fun(count_lines_in_files_2)(Rng &&files)(
   return results;
 }
 
-static void naive(benchmark::State &state) {
+BENCHMARK_DEFINE_F(corpus_fixture, naive)(benchmark::State &state) {
+  for (auto _ : state) {
+    prepare(state);
+    auto lines = count_lines_in_files_2(files());
+    bench::consume(lines);
+  }
+  check_lines(state, count_lines_in_files_2(files()));
+  report(state);
+}
+BENCHMARK_REGISTER_F(corpus_fixture, naive)
+  ->Apply(corpus_fixture::arguments);
+
+template <typename Rng> auto CPP_fun(count_lines_in_files_mapped)(Rng &&files)(
+  requires ranges::range<Rng>) {
+  std::vector<std::ptrdiff_t> results;
+
+  for (const auto &file : files) {
+    std::ptrdiff_t line_count = 0;
+
+    // a single block for a memory mapped file, buffer sized blocks otherwise
+    utility::for_each_block(file, [&](const char *first, const char *last) {
+      line_count += utility::simd::count(first, last, '\n');
+    });
+
+    results.push_back(line_count);
+  }
+
+  return results;
+}
+
+BENCHMARK_DEFINE_F(corpus_fixture, mapped)(benchmark::State &state) {
+  for (auto _ : state) {
+    prepare(state);
+    auto lines = count_lines_in_files_mapped(files());
+    bench::consume(lines);
+  }
+  check_lines(state, count_lines_in_files_mapped(files()));
+  report(state);
+}
+BENCHMARK_REGISTER_F(corpus_fixture, mapped)
+  ->Apply(corpus_fixture::arguments);
+
+template <typename Rng> auto CPP_fun(count_lines_in_files_chunked)(Rng &&files)(
+  requires ranges::range<Rng>) {
+  auto count_lines = [](const std::string &filename) {
+    auto count_chunk = [](utility::byte_span chunk) {
+      const auto first = reinterpret_cast<const char *>(chunk.data());
+      return utility::simd::count(first, first + chunk.size(), '\n');
+    };
+    return ranges::accumulate(utility::views::file_chunks(filename)
+                                | ranges::views::transform(count_chunk),
+                              std::ptrdiff_t{0});
+  };
+
+  return files | ranges::views::transform(count_lines);
+}
+
+BENCHMARK_DEFINE_F(corpus_fixture, chunked)(benchmark::State &state) {
   for (auto _ : state) {
-    auto lines =
-      count_lines_in_files_2(ranges::views::single(std::string{__FILE__}));
-    // Make sure the variable is not optimized away by compiler
-    benchmark::DoNotOptimize(lines);
+    prepare(state);
+    auto lines = count_lines_in_files_chunked(files());
+    // Read every count, otherwise a lazy pipeline never opens a file
+    bench::consume(lines);
   }
+  check_lines(state, count_lines_in_files_chunked(files()));
+  report(state);
 }
-BENCHMARK(naive)->Range(8, 8 << 11);
+BENCHMARK_REGISTER_F(corpus_fixture, chunked)
+  ->Apply(corpus_fixture::arguments);
+
+template <typename Rng> auto CPP_fun(count_lines_in_files_joined)(Rng &&files)(
+  requires ranges::range<Rng>) {
+  auto count_lines = [](const std::string &filename) {
+    return ranges::count(utility::views::file_chunks(filename)
+                           | ranges::views::join,
+                         std::byte{'\n'});
+  };
+
+  return files | ranges::views::transform(count_lines);
+}
+
+BENCHMARK_DEFINE_F(corpus_fixture, joined)(benchmark::State &state) {
+  for (auto _ : state) {
+    prepare(state);
+    auto lines = count_lines_in_files_joined(files());
+    // Read every count, otherwise a lazy pipeline never opens a file
+    bench::consume(lines);
+  }
+  check_lines(state, count_lines_in_files_joined(files()));
+  report(state);
+}
+BENCHMARK_REGISTER_F(corpus_fixture, joined)
+  ->Apply(corpus_fixture::arguments);
+
+template <typename Rng>
+auto CPP_fun(count_lines_in_files_read_ahead)(Rng &&files)(
+  requires ranges::range<Rng>) {
+  auto count_lines = [](const std::string &filename) {
+    auto count_chunk = [](utility::byte_span chunk) {
+      const auto first = reinterpret_cast<const char *>(chunk.data());
+      return utility::simd::count(first, first + chunk.size(), '\n');
+    };
+    return ranges::accumulate(utility::views::read_ahead(filename)
+                                | ranges::views::transform(count_chunk),
+                              std::ptrdiff_t{0});
+  };
+
+  return files | ranges::views::transform(count_lines);
+}
+
+BENCHMARK_DEFINE_F(corpus_fixture, read_ahead)(benchmark::State &state) {
+  for (auto _ : state) {
+    prepare(state);
+    auto lines = count_lines_in_files_read_ahead(files());
+    // Read every count, otherwise a lazy pipeline never opens a file
+    bench::consume(lines);
+  }
+  check_lines(state, count_lines_in_files_read_ahead(files()));
+  report(state);
+}
+// reads happen on another thread, only wall clock time is meaningful
+BENCHMARK_REGISTER_F(corpus_fixture, read_ahead)
+  ->Apply(corpus_fixture::arguments)
+  ->UseRealTime();
+
+// all of wc statistics in a single pass
+template <typename Rng> auto CPP_fun(wc_in_files_fused)(Rng &&files)(
+  requires ranges::range<Rng>) {
+  auto stats = [](const std::string &filename) {
+    utility::text_stats_counter counter;
+    utility::for_each_block(filename, counter);
+    return counter.result();
+  };
+
+  return files | ranges::views::transform(stats);
+}
+
+BENCHMARK_DEFINE_F(corpus_fixture, wc_fused)(benchmark::State &state) {
+  for (auto _ : state) {
+    prepare(state);
+    auto stats = wc_in_files_fused(files());
+    // Read every result, otherwise a lazy pipeline never opens a file
+    bench::consume(stats);
+  }
+  check_lines(state, wc_in_files_fused(files())
+                       | ranges::views::transform(
+                         [](const utility::text_stats &stats) {
+                           return stats.lines;
+                         }));
+  report(state);
+}
+BENCHMARK_REGISTER_F(corpus_fixture, wc_fused)
+  ->Apply(corpus_fixture::arguments);
+
+// one pass over a memory mapping per statistic
+template <typename Rng> auto CPP_fun(wc_in_files_passes)(Rng &&files)(
+  requires ranges::range<Rng>) {
+  auto stats = [](const std::string &filename) {
+    const utility::mapped_file file{filename};
+    const auto text = file.data();
+    utility::text_stats result;
+    result.bytes = ranges::distance(file);
+    result.lines = ranges::count(file, '\n');
+    result.words = ranges::count_if(
+      ranges::views::iota(std::size_t{0}, file.size()), [text](std::size_t i) {
+        return !utility::is_space(text[i])
+               && (i == 0 || utility::is_space(text[i - 1]));
+      });
+    if (auto lines = utility::views::lines(file); !lines.empty()) {
+      result.max_line_length = ranges::max(
+        lines | ranges::views::transform([](std::string_view line) {
+          return static_cast<int64_t>(line.size());
+        }));
+    }
+    return result;
+  };
+
+  return files | ranges::views::transform(stats);
+}
+
+BENCHMARK_DEFINE_F(corpus_fixture, wc_passes)(benchmark::State &state) {
+  for (auto _ : state) {
+    prepare(state);
+    auto stats = wc_in_files_passes(files());
+    // Read every result, otherwise a lazy pipeline never opens a file
+    bench::consume(stats);
+  }
+  check_lines(state, wc_in_files_passes(files())
+                       | ranges::views::transform(
+                         [](const utility::text_stats &stats) {
+                           return stats.lines;
+                         }));
+  report(state);
+}
+BENCHMARK_REGISTER_F(corpus_fixture, wc_passes)
+  ->Apply(corpus_fixture::arguments);
+
+// I/O bound comparison: a corpus read from disk rather than the page cache.
+// without posix_fadvise the cache cannot be dropped, the large corpora are
+// then read warm and labelled so.
+static void io_bound_arguments(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"files", "bytes", "lengths", "cold"});
+  const auto lengths = static_cast<int64_t>(bench::line_lengths::uniform);
+#ifdef BENCH_HAS_FADVISE
+  const int64_t cold = 1;
+#else
+  const int64_t cold = 0;
+#endif
+  b->Args({1, int64_t{1} << 30, lengths, cold});
+  b->Args({16, 64 << 20, lengths, cold});
+  b->Iterations(3);
+  b->UseRealTime();
+}
+
+#define IO_BOUND_BENCHMARK(name)                                               \
+  BENCHMARK_REGISTER_F(corpus_fixture, name)->Apply(io_bound_arguments);
+
+IO_BOUND_BENCHMARK(rangify)
+IO_BOUND_BENCHMARK(naive)
+IO_BOUND_BENCHMARK(chunked)
+IO_BOUND_BENCHMARK(read_ahead)
+
+template <typename Rng>
+auto CPP_fun(count_lines_in_files_parallel)(Rng &&files,
+                                            utility::thread_pool &pool,
+                                            std::size_t chunk_size = 1 << 22)(
+  requires ranges::range<Rng>) {
+  std::vector<std::string> filenames;
+  for (const auto &file : files) {
+    filenames.emplace_back(file);
+  }
+
+  // one slot per input file, so results keep the input order whatever the
+  // order tasks complete in
+  std::vector<std::atomic<std::ptrdiff_t>> counts(filenames.size());
+
+  utility::task_group group{pool};
+  for (std::size_t index = 0; index != filenames.size(); ++index) {
+    group.run([&, index] {
+      auto file = std::make_shared<utility::mapped_file>(filenames[index]);
+      if (!*file) {
+        std::ptrdiff_t line_count = 0;
+        utility::for_each_block(filenames[index],
+                                [&](const char *first, const char *last) {
+                                  line_count +=
+                                    utility::simd::count(first, last, '\n');
+                                });
+        counts[index] = line_count;
+        return;
+      }
+
+      // split large files so that a single one does not hold up a worker.
+      // chunks share ownership of the mapping.
+      for (std::size_t offset = chunk_size; offset < file->size();
+           offset += chunk_size) {
+        group.run([&, index, file, offset] {
+          const auto last = file->data()
+                            + std::min(offset + chunk_size, file->size());
+          counts[index] +=
+            utility::simd::count(file->data() + offset, last, '\n');
+        });
+      }
+      counts[index] += utility::simd::count(
+        file->data(), file->data() + std::min(chunk_size, file->size()),
+        '\n');
+    });
+  }
+  group.wait();
+
+  return std::vector<std::ptrdiff_t>(counts.begin(), counts.end());
+}
+
+BENCHMARK_DEFINE_F(corpus_fixture, parallel)(benchmark::State &state) {
+  // the benchmark thread runs tasks while it waits for them
+  utility::thread_pool pool{static_cast<std::size_t>(state.range(4) - 1)};
+  for (auto _ : state) {
+    prepare(state);
+    auto lines = count_lines_in_files_parallel(files(), pool);
+    bench::consume(lines);
+  }
+  check_lines(state, count_lines_in_files_parallel(files(), pool));
+  report(state);
+  state.counters["threads"] = static_cast<double>(pool.size() + 1);
+}
+// many small files, then a single large one which has to be split
+BENCHMARK_REGISTER_F(corpus_fixture, parallel)
+  ->Apply([](benchmark::internal::Benchmark *b) {
+    b->ArgNames({"files", "bytes", "lengths", "cold", "threads"});
+    const auto lengths = static_cast<int64_t>(bench::line_lengths::uniform);
+    for (int64_t threads = 1; threads <= std::thread::hardware_concurrency();
+         threads *= 2) {
+      b->Args({4096, 4 << 10, lengths, 0, threads});
+      b->Args({1, 64 << 20, lengths, 0, threads});
+    }
+  })
+  ->UseRealTime();
 
 BENCHMARK_MAIN();
\ No newline at end of file
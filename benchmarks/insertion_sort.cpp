@@ -1,12 +1,15 @@
 #include <algorithm>
+#include <bench/consume.hpp>
+#include <bench/sorting.hpp>
 #include <benchmark/benchmark.h>
 #include <list>
-#include <random>
+#include <string>
 #include <utility/missing_utilities.hpp>
+#include <utility/sort.hpp>
 #ifdef USE_RANGE_V3
 #include <range/v3/view/counted.hpp>
 #else
-#include <experimental/ranges/ranges>
+#include <utility/ranges.hpp>
 #endif
 
 using namespace ranges;
@@ -19,36 +22,75 @@ void CPP_fun(insertion_sort)(I begin, S end)(requires ranges::sentinel_for<S, I>
   }
 }
 
-auto createList(int64_t N) {
-  std::mt19937 gen;
-  std::uniform_int_distribution<> dis(0, static_cast<int>(N));
-  std::list<int> list;
-  std::generate_n(std::back_inserter(list), N, [&]() { return dis(gen); });
-  return list;
-}
+using bench::sort_fixture;
+using string = std::string;
 
-static void naive(benchmark::State &state) {
+template <typename T>
+static void naive(sort_fixture<T> &fixture, benchmark::State &state) {
+  std::list<T> list;
   // Code inside this loop is measured repeatedly
-  auto list = createList(state.range(0));
   for (auto _ : state) {
+    // a fresh copy of the input, not measured
+    fixture.restore(state, list);
     insertion_sort(list.begin(), list.end());
     // Make sure the variable is not optimized away by compiler
-    benchmark::DoNotOptimize(list);
+    bench::do_not_optimize(list);
   }
+  fixture.report(state);
 }
-// Register the function as a benchmark
-BENCHMARK(naive)->Range(8, 8 << 11);
 
-static void counted(benchmark::State &state) {
-  // Code before the loop is not measured
-  auto list = createList(state.range(0));
+template <typename T>
+static void counted(sort_fixture<T> &fixture, benchmark::State &state) {
+  std::list<T> list;
   for (auto _ : state) {
+    fixture.restore(state, list);
     auto counted = views::counted(list.begin(), list.size());
     insertion_sort(counted.begin(), counted.end());
     // Make sure the variable is not optimized away by compiler
-    benchmark::DoNotOptimize(list);
+    bench::do_not_optimize(list);
+  }
+  fixture.report(state);
+}
+
+template <typename T>
+static void container_sort(sort_fixture<T> &fixture, benchmark::State &state) {
+  std::list<T> list;
+  for (auto _ : state) {
+    fixture.restore(state, list);
+    // relinks the nodes
+    utility::sort(list);
+    bench::do_not_optimize(list);
+  }
+  fixture.report(state);
+}
+
+template <typename T>
+static void staged_sort(sort_fixture<T> &fixture, benchmark::State &state) {
+  std::list<T> list;
+  for (auto _ : state) {
+    fixture.restore(state, list);
+    // not a container, sorted in a contiguous buffer
+    utility::sort(views::counted(list.begin(), list.size()));
+    bench::do_not_optimize(list);
   }
+  fixture.report(state);
 }
-BENCHMARK(counted)->Range(8, 8 << 11);
+
+// Register the function as a benchmark for a key type
+#define SORT_BENCHMARK(func, type)                                             \
+  BENCHMARK_TEMPLATE_DEFINE_F(sort_fixture, func##_##type, type)               \
+  (benchmark::State & state) { func(*this, state); }                           \
+  BENCHMARK_REGISTER_F(sort_fixture, func##_##type)                            \
+    ->Apply(sort_fixture<type>::arguments<>);
+
+#define SORT_BENCHMARKS(func)                                                  \
+  SORT_BENCHMARK(func, int)                                                    \
+  SORT_BENCHMARK(func, double)                                                 \
+  SORT_BENCHMARK(func, string)
+
+SORT_BENCHMARKS(naive)
+SORT_BENCHMARKS(counted)
+SORT_BENCHMARKS(container_sort)
+SORT_BENCHMARKS(staged_sort)
 
 BENCHMARK_MAIN();
@@ -0,0 +1,59 @@
+#include <bench/consume.hpp>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <range/v3/view/getlines.hpp>
+#include <sstream>
+#include <string>
+#include <utility/lines.hpp>
+
+// deterministic text of `size` bytes with lines of 0 to 160 characters
+static std::string make_text(int64_t size, const char *terminator = "\n") {
+  std::mt19937 gen;
+  std::uniform_int_distribution<int> length{0, 160};
+  std::uniform_int_distribution<int> printable{' ', '~'};
+  std::string text;
+  text.reserve(static_cast<size_t>(size));
+  while (static_cast<int64_t>(text.size()) < size) {
+    for (auto i = length(gen); i > 0; --i) {
+      text.push_back(static_cast<char>(printable(gen)));
+    }
+    text += terminator;
+  }
+  text.resize(static_cast<size_t>(size));
+  return text;
+}
+
+static void getlines(benchmark::State &state) {
+  const auto text = make_text(state.range(0));
+  std::istringstream stream;
+  for (auto _ : state) {
+    // Code between PauseTiming and ResumeTiming is not measured
+    state.PauseTiming();
+    stream.clear();
+    stream.str(text);
+    state.ResumeTiming();
+    bench::consume(ranges::getlines(stream));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(getlines)->Range(1 << 10, 1 << 26);
+
+static void lines(benchmark::State &state) {
+  const auto text = make_text(state.range(0));
+  for (auto _ : state) {
+    bench::consume(utility::views::lines(text));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(lines)->Range(1 << 10, 1 << 26);
+
+static void lines_strip_cr(benchmark::State &state) {
+  const auto text = make_text(state.range(0), "\r\n");
+  for (auto _ : state) {
+    bench::consume(utility::views::lines(text, true));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(lines_strip_cr)->Range(1 << 10, 1 << 26);
+
+BENCHMARK_MAIN();
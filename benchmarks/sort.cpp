@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <bench/consume.hpp>
+#include <bench/sorting.hpp>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility/execution.hpp>
+#include <utility/parallel_sort.hpp>
+#include <utility/pdq_sort.hpp>
+#include <utility/powersort.hpp>
+#include <utility/radix_sort.hpp>
+#include <utility/thread_pool.hpp>
+#ifdef USE_RANGE_V3
+#include <range/v3/algorithm/sort.hpp>
+#include <range/v3/algorithm/stable_sort.hpp>
+#else
+#include <utility/missing_utilities.hpp>
+#include <utility/ranges.hpp>
+#endif
+#include <vector>
+
+struct record {
+  int64_t id;
+  std::string name;
+  double salary;
+};
+
+// records are ordered the same by each of their fields
+template <> inline record bench::detail::make_key<record>(int64_t rank) {
+  return {rank, make_key<std::string>(rank), make_key<double>(rank)};
+}
+
+using bench::sort_fixture;
+using string = std::string;
+
+constexpr auto by_value = [](const auto &value) -> const auto & {
+  return value;
+};
+
+template <typename T, typename Proj>
+static void std_sort(sort_fixture<T> &fixture, benchmark::State &state,
+                     Proj proj) {
+  std::vector<T> data;
+  for (auto _ : state) {
+    // a fresh copy of the input, not measured
+    fixture.restore(state, data);
+    std::sort(data.begin(), data.end(), [&](const T &lhs, const T &rhs) {
+      return std::invoke(proj, lhs) < std::invoke(proj, rhs);
+    });
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+}
+
+template <typename T, typename Proj>
+static void ranges_sort(sort_fixture<T> &fixture, benchmark::State &state,
+                        Proj proj) {
+  std::vector<T> data;
+  for (auto _ : state) {
+    fixture.restore(state, data);
+    ranges::sort(data, {}, proj);
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+}
+
+template <typename T, typename Proj>
+static void ranges_stable_sort(sort_fixture<T> &fixture,
+                               benchmark::State &state, Proj proj) {
+  std::vector<T> data;
+  for (auto _ : state) {
+    fixture.restore(state, data);
+    ranges::stable_sort(data, {}, proj);
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+}
+
+template <typename T, typename Proj>
+static void pdq_sort(sort_fixture<T> &fixture, benchmark::State &state,
+                     Proj proj) {
+  std::vector<T> data;
+  for (auto _ : state) {
+    fixture.restore(state, data);
+    utility::pdq_sort(data, {}, proj);
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+}
+
+template <typename T, typename Proj>
+static void radix_sort(sort_fixture<T> &fixture, benchmark::State &state,
+                       Proj proj) {
+  std::vector<T> data;
+  for (auto _ : state) {
+    fixture.restore(state, data);
+    utility::radix_sort(data, proj);
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+}
+
+template <typename T, typename Proj>
+static void powersort(sort_fixture<T> &fixture, benchmark::State &state,
+                      Proj proj) {
+  std::vector<T> data;
+  // allocated by the first iteration only
+  std::vector<T> scratch;
+  for (auto _ : state) {
+    fixture.restore(state, data);
+    utility::powersort(data, scratch, {}, proj);
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+}
+
+// radix sorts pay off once the input is well past the caches. ints go up to
+// about 10^8 elements, strings and records, which take more memory each, up
+// to about 10^7
+constexpr int64_t max_int_size    = 1 << 26;
+constexpr int64_t max_record_size = 1 << 23;
+
+// registers a sort for a key type, optionally projected from a record
+#define SORT_BENCHMARK(func, type, key, proj, max_size)                        \
+  BENCHMARK_TEMPLATE_DEFINE_F(sort_fixture, func##_##key, type)                \
+  (benchmark::State & state) { func(*this, state, proj); }                     \
+  BENCHMARK_REGISTER_F(sort_fixture, func##_##key)                             \
+    ->Apply(sort_fixture<type>::arguments<max_size>);
+
+#define SORT_BENCHMARKS(func)                                                  \
+  SORT_BENCHMARK(func, int, int, by_value, max_int_size)                       \
+  SORT_BENCHMARK(func, string, string, by_value, max_record_size)              \
+  SORT_BENCHMARK(func, record, record_id, &record::id, max_record_size)        \
+  SORT_BENCHMARK(func, record, record_name, &record::name, max_record_size)
+
+SORT_BENCHMARKS(std_sort)
+SORT_BENCHMARKS(ranges_sort)
+SORT_BENCHMARKS(ranges_stable_sort)
+SORT_BENCHMARKS(pdq_sort)
+SORT_BENCHMARKS(powersort)
+SORT_BENCHMARKS(radix_sort)
+
+// benchmark arguments are the sort_fixture ones, then the number of threads,
+// the benchmark thread among them: it runs tasks while it waits for them
+template <int64_t MaxSize>
+static void thread_arguments(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"size", "distribution", "threads"});
+  const auto max_threads =
+    static_cast<int64_t>(std::max(1U, std::thread::hardware_concurrency()));
+  for (int64_t size = 1 << 20; size <= MaxSize; size *= 8) {
+    for (const auto d :
+         {bench::distribution::random, bench::distribution::few_unique}) {
+      for (int64_t threads = 1; threads <= max_threads; threads *= 2) {
+        b->Args({size, static_cast<int64_t>(d), threads});
+      }
+    }
+  }
+}
+
+template <typename T, typename Proj>
+static void parallel_sort(sort_fixture<T> &fixture, benchmark::State &state,
+                          Proj proj) {
+  utility::thread_pool pool{static_cast<size_t>(state.range(2) - 1)};
+  const auto policy = utility::execution::par.on(pool);
+  std::vector<T> data;
+  for (auto _ : state) {
+    fixture.restore(state, data);
+    utility::sort(policy, data, {}, proj);
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+  state.counters["threads"] = static_cast<double>(pool.size() + 1);
+}
+
+template <typename T, typename Proj>
+static void parallel_stable_sort(sort_fixture<T> &fixture,
+                                 benchmark::State &state, Proj proj) {
+  utility::thread_pool pool{static_cast<size_t>(state.range(2) - 1)};
+  const auto policy = utility::execution::par.on(pool);
+  std::vector<T> data;
+  for (auto _ : state) {
+    fixture.restore(state, data);
+    utility::stable_sort(policy, data, {}, proj);
+    bench::do_not_optimize(data);
+  }
+  fixture.report(state);
+  state.counters["threads"] = static_cast<double>(pool.size() + 1);
+}
+
+#define PARALLEL_SORT_BENCHMARK(func, type, key, proj, max_size)               \
+  BENCHMARK_TEMPLATE_DEFINE_F(sort_fixture, func##_##key, type)                \
+  (benchmark::State & state) { func(*this, state, proj); }                     \
+  BENCHMARK_REGISTER_F(sort_fixture, func##_##key)                             \
+    ->Apply(thread_arguments<max_size>)                                        \
+    ->UseRealTime();
+
+#define PARALLEL_SORT_BENCHMARKS(func)                                         \
+  PARALLEL_SORT_BENCHMARK(func, int, int, by_value, max_int_size)              \
+  PARALLEL_SORT_BENCHMARK(func, string, string, by_value, max_record_size)     \
+  PARALLEL_SORT_BENCHMARK(func, record, record_id, &record::id,                \
+                          max_record_size)                                     \
+  PARALLEL_SORT_BENCHMARK(func, record, record_name, &record::name,            \
+                          max_record_size)
+
+PARALLEL_SORT_BENCHMARKS(parallel_sort)
+PARALLEL_SORT_BENCHMARKS(parallel_stable_sort)
+
+BENCHMARK_MAIN();
@@ -0,0 +1,85 @@
+#include <bench/consume.hpp>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#ifdef USE_RANGE_V3
+#include <range/v3/iterator/operations.hpp>
+#include <range/v3/view/split.hpp>
+#include <range/v3/view/split_when.hpp>
+#else
+#include <utility/missing_utilities.hpp>
+#include <utility/ranges.hpp>
+#endif
+#include <string>
+#include <string_view>
+#include <utility/split.hpp>
+#include <vector>
+
+// deterministic text of `size` bytes, words of 1 to 12 letters separated by
+// one of `separators`
+static std::string make_text(int64_t size,
+                             const std::vector<std::string> &separators) {
+  std::mt19937 gen;
+  std::uniform_int_distribution<int> length{1, 12};
+  std::uniform_int_distribution<int> letter{'a', 'z'};
+  std::uniform_int_distribution<size_t> separator{0, separators.size() - 1};
+  std::string text;
+  text.reserve(static_cast<size_t>(size));
+  while (static_cast<int64_t>(text.size()) < size) {
+    for (auto i = length(gen); i > 0; --i) {
+      text.push_back(static_cast<char>(letter(gen)));
+    }
+    text += separators[separator(gen)];
+  }
+  text.resize(static_cast<size_t>(size));
+  return text;
+}
+
+// counts the pieces and their characters, so that every piece is walked
+// when it is not sized
+template <typename Rng> static int64_t characters(Rng &&pieces) {
+  int64_t total = 0;
+  for (auto &&piece : pieces) {
+    total += 1 + static_cast<int64_t>(ranges::distance(piece));
+  }
+  return total;
+}
+
+static const std::vector<std::string> spaces{" "};
+static const std::vector<std::string> colons{"::"};
+static const std::vector<std::string> whitespace{" ", "\t", "\n"};
+
+template <typename F>
+static void do_benchmark(benchmark::State &state,
+                         const std::vector<std::string> &separators, F split) {
+  const auto text = make_text(state.range(0), separators);
+  for (auto _ : state) {
+    bench::do_not_optimize(characters(split(text)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+#define SPLIT_BENCHMARK(name, separators, ...)                                 \
+  BENCHMARK_CAPTURE(do_benchmark, name, separators,                            \
+                    [](const std::string &text) { return __VA_ARGS__; })       \
+    ->Range(1 << 10, 1 << 24)
+
+SPLIT_BENCHMARK(ranges_split_char, spaces, ranges::views::split(text, ' '));
+SPLIT_BENCHMARK(utility_split_char, spaces, utility::views::split(text, ' '));
+
+SPLIT_BENCHMARK(ranges_split_string, colons,
+                ranges::views::split(text, std::string_view{"::"}));
+SPLIT_BENCHMARK(utility_split_string, colons,
+                utility::views::split(text, "::"));
+
+#ifdef USE_RANGE_V3
+// range-v3 only
+SPLIT_BENCHMARK(ranges_split_when, whitespace,
+                ranges::views::split_when(text, [](char c) {
+                  return c == ' ' || c == '\t' || c == '\n';
+                }));
+#endif
+SPLIT_BENCHMARK(utility_split_any_of, whitespace,
+                utility::views::split(text, utility::any_of{" \t\n"}));
+
+BENCHMARK_MAIN();
@@ -1,67 +1,215 @@
 #include <algorithm>
+#include <bench/allocations.hpp>
+#include <bench/consume.hpp>
 #include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
 #include <numeric>
 #ifdef USE_RANGE_V3
 #include <range/v3/all.hpp>
 #else
-#include <experimental/ranges/algorithm>
-#include <experimental/ranges/ranges>
-namespace ranges = std::experimental::ranges;
+#include <utility/missing_utilities.hpp>
+#include <utility/ranges.hpp>
 #endif
+#include <utility/reduce.hpp>
+#include <utility/simd_chunk.hpp>
+#include <utility/thread_pool.hpp>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
+// sums of squares grow as count^3 / 3, which overflows 32 bits integers over
+// the benchmarked counts. only signed integers are widened, overflowing them
+// is undefined: unsigned arithmetic wraps and floating point rounds, both
+// square and sum in their own type.
+template <typename T>
+using accumulator_t =
+  std::conditional_t<std::is_integral_v<T> && std::is_signed_v<T>, int64_t, T>;
+
+template <typename T> struct square {
+  accumulator_t<T> operator()(T x) const {
+    return static_cast<accumulator_t<T>>(x) * static_cast<accumulator_t<T>>(x);
+  }
+};
+
+// 1, 2, ..., count - 1 as values of type T. iota requires an integral type
+// and iota over 64 bits integers has a difference type wider than 64 bits,
+// count over int and convert.
+template <typename T> static auto numbers(int count) {
+  using namespace ranges;
+  return views::iota(1, count)
+         | views::transform([](int x) { return static_cast<T>(x); });
+}
+
 template <typename F> static auto do_benchmark(benchmark::State &state, F &&f) {
+  const bench::allocation_counter allocations;
   // Code inside this loop is measured repeatedly
   for (auto _ : state) {
     const auto total = std::forward<F>(f)(static_cast<int>(state.range(0)));
 
     // Make sure the variable is not optimized away by compiler
-    benchmark::DoNotOptimize(total);
+    bench::do_not_optimize(total);
   }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  allocations.report(state);
 }
 
+#define DO_TYPED_BENCHMARK(func, type, name)                                   \
+  BENCHMARK_CAPTURE(do_benchmark, func/name, func<type>)                       \
+    ->Range(8 << 4, 8 << 16);
+
 #define DO_BENCHMARK(func)                                                     \
-  BENCHMARK_CAPTURE(do_benchmark, func, func)->Range(8 << 4, 8 << 16);
-
-int classic_stl(int count) {
-  std::vector<int> numbers(static_cast<size_t>(count));
-  std::iota(numbers.begin(), numbers.end(), 1);
-  std::transform(numbers.begin(), numbers.end(), numbers.begin(),
-                 [](int x) { return x * x; });
-  return std::accumulate(numbers.begin(), numbers.end(), 0);
+  DO_TYPED_BENCHMARK(func, int32_t, int32)                                     \
+  DO_TYPED_BENCHMARK(func, int64_t, int64)                                     \
+  DO_TYPED_BENCHMARK(func, uint32_t, uint32)                                   \
+  DO_TYPED_BENCHMARK(func, float, float)                                       \
+  DO_TYPED_BENCHMARK(func, double, double)
+
+template <typename T> accumulator_t<T> classic_stl(int count) {
+  std::vector<T> numbers(static_cast<size_t>(count));
+  std::iota(numbers.begin(), numbers.end(), T{1});
+  std::vector<accumulator_t<T>> squares(numbers.size());
+  std::transform(numbers.begin(), numbers.end(), squares.begin(), square<T>{});
+  return std::accumulate(squares.begin(), squares.end(), accumulator_t<T>{});
 }
 
 DO_BENCHMARK(classic_stl)
 
-int for_loop(int count) {
-  int total = 0;
-  for (auto i = 1; i <= count; ++i) {
-    total += i * i;
+#if __has_include(<memory_resource>)
+// same as classic_stl, but the vectors live in a buffer which is reused by
+// every iteration, so that only the cost of filling them is measured and not
+// the one of allocating and faulting in fresh memory
+template <typename T> accumulator_t<T> classic_stl_arena(int count) {
+  static std::vector<std::byte> buffer;
+  const auto size = static_cast<size_t>(count);
+  // with room to align both vectors
+  const auto capacity = size * (sizeof(T) + sizeof(accumulator_t<T>))
+                        + alignof(T) + alignof(accumulator_t<T>);
+  if (buffer.size() < capacity) {
+    buffer.resize(capacity);
+  }
+  std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource()};
+
+  std::pmr::vector<T> numbers(size, &arena);
+  std::iota(numbers.begin(), numbers.end(), T{1});
+  std::pmr::vector<accumulator_t<T>> squares(numbers.size(), &arena);
+  std::transform(numbers.begin(), numbers.end(), squares.begin(), square<T>{});
+  return std::accumulate(squares.begin(), squares.end(), accumulator_t<T>{});
+}
+
+DO_BENCHMARK(classic_stl_arena)
+#endif
+
+template <typename T> accumulator_t<T> for_loop(int count) {
+  accumulator_t<T> total{};
+  for (auto i = T{1}; i <= static_cast<T>(count); ++i) {
+    total += square<T>{}(i);
   }
   return total;
 }
 
 DO_BENCHMARK(for_loop)
 
-int ranges_function_call(int count) {
+template <typename T> accumulator_t<T> ranges_function_call(int count) {
   using namespace ranges;
   return accumulate(
     views::transform(
-      views::iota(1, count), 
-      [](int x) { return x * x; }
-    ), 0
+      numbers<T>(count), 
+      square<T>{}
+    ), accumulator_t<T>{}
   );
 }
 
 DO_BENCHMARK(ranges_function_call)
 
-int ranges_pipeline(int count) {
+template <typename T> accumulator_t<T> ranges_pipeline(int count) {
   using namespace ranges;
-  auto squares = views::iota(1, count) 
-               | views::transform([](int x) { return x * x; });
-  return accumulate(squares, 0);
+  auto squares = numbers<T>(count) 
+               | views::transform(square<T>{});
+  return accumulate(squares, accumulator_t<T>{});
 }
 
 DO_BENCHMARK(ranges_pipeline)
 
+#ifdef UTILITY_HAS_STD_SIMD
+// squares are computed lane-wise, so signed elements are widened to the
+// accumulator type before they are split into batches
+template <typename T> accumulator_t<T> simd_pipeline(int count) {
+  using namespace ranges;
+  auto squares = numbers<accumulator_t<T>>(count)
+               | utility::views::simd_chunk
+               | views::transform([](auto x) { return x * x; });
+  return utility::simd::accumulate(squares, accumulator_t<T>{});
+}
+
+DO_BENCHMARK(simd_pipeline)
+#endif
+
+// arguments are the count and the number of threads, the benchmark thread
+// among them: it runs tasks while it waits for them
+static void threads_arguments(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"count", "threads"});
+  const auto max_threads =
+    static_cast<int64_t>(std::max(1U, std::thread::hardware_concurrency()));
+  // the sum of the squares of 8 << 18 numbers is the largest which fits in
+  // int64_t
+  for (const int64_t count : {8 << 10, 8 << 14, 8 << 18}) {
+    for (int64_t threads = 1; threads <= max_threads; threads *= 2) {
+      b->Args({count, threads});
+    }
+  }
+}
+
+template <typename F>
+static void do_parallel_benchmark(benchmark::State &state, F &&f) {
+  utility::thread_pool pool{static_cast<size_t>(state.range(1) - 1)};
+  const auto policy = utility::execution::par.on(pool);
+  const bench::allocation_counter allocations;
+  for (auto _ : state) {
+    const auto total = f(policy, static_cast<int>(state.range(0)));
+    bench::do_not_optimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  allocations.report(state);
+  state.counters["threads"] = static_cast<double>(pool.size() + 1);
+}
+
+#define DO_TYPED_PARALLEL_BENCHMARK(func, type, name)                          \
+  BENCHMARK_CAPTURE(do_parallel_benchmark, func/name, func<type>)              \
+    ->Apply(threads_arguments)                                                 \
+    ->UseRealTime();
+
+#define DO_PARALLEL_BENCHMARK(func)                                            \
+  DO_TYPED_PARALLEL_BENCHMARK(func, int32_t, int32)                            \
+  DO_TYPED_PARALLEL_BENCHMARK(func, int64_t, int64)                            \
+  DO_TYPED_PARALLEL_BENCHMARK(func, uint32_t, uint32)                          \
+  DO_TYPED_PARALLEL_BENCHMARK(func, float, float)                              \
+  DO_TYPED_PARALLEL_BENCHMARK(func, double, double)
+
+template <typename T>
+accumulator_t<T> parallel_pipeline(utility::execution::parallel_policy policy,
+                                   int count) {
+  using namespace ranges;
+  auto squares = numbers<T>(count) 
+               | views::transform(square<T>{});
+  return utility::reduce(policy, squares, accumulator_t<T>{});
+}
+
+DO_PARALLEL_BENCHMARK(parallel_pipeline)
+
+template <typename T>
+accumulator_t<T>
+parallel_transform_reduce(utility::execution::parallel_policy policy,
+                          int count) {
+  return utility::transform_reduce(policy, numbers<T>(count),
+                                   accumulator_t<T>{}, std::plus<>{},
+                                   square<T>{});
+}
+
+DO_PARALLEL_BENCHMARK(parallel_transform_reduce)
+
 BENCHMARK_MAIN();
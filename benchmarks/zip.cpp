@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <bench/allocations.hpp>
+#include <bench/consume.hpp>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#ifdef USE_RANGE_V3
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/transform.hpp>
+#include <range/v3/view/zip.hpp>
+#include <range/v3/view/zip_with.hpp>
+#else
+#include <utility/missing_utilities.hpp>
+#include <utility/ranges.hpp>
+#endif
+#include <utility>
+#include <vector>
+
+// the former views::zip of the stl2 and nanorange backends, which copies
+// both ranges into a vector of pairs
+template <typename R1, typename R2>
+static auto eager_zip(const R1 &rng1, const R2 &rng2) {
+  using value_type =
+    std::pair<typename R1::value_type, typename R2::value_type>;
+  std::vector<value_type> pairs;
+  std::transform(std::begin(rng1), std::end(rng1), std::begin(rng2),
+                 std::back_inserter(pairs),
+                 [](const auto &val1, const auto &val2) {
+                   return value_type{val1, val2};
+                 });
+  return pairs;
+}
+
+static int64_t dot_for_loop(const std::vector<int> &lhs,
+                            const std::vector<int> &rhs) {
+  int64_t total = 0;
+  for (size_t index = 0; index != lhs.size(); ++index) {
+    total += int64_t{lhs[index]} * rhs[index];
+  }
+  return total;
+}
+
+static int64_t dot_eager_zip(const std::vector<int> &lhs,
+                             const std::vector<int> &rhs) {
+  int64_t total = 0;
+  for (const auto &[x, y] : eager_zip(lhs, rhs)) {
+    total += int64_t{x} * y;
+  }
+  return total;
+}
+
+static int64_t dot_zip(const std::vector<int> &lhs,
+                       const std::vector<int> &rhs) {
+  using namespace ranges;
+  int64_t total = 0;
+  for (const auto &[x, y] : views::zip(lhs, rhs)) {
+    total += int64_t{x} * y;
+  }
+  return total;
+}
+
+static int64_t dot_zip_with(const std::vector<int> &lhs,
+                            const std::vector<int> &rhs) {
+  using namespace ranges;
+  int64_t total = 0;
+  for (const auto product : views::zip_with(
+         [](int x, int y) { return int64_t{x} * y; }, lhs, rhs)) {
+    total += product;
+  }
+  return total;
+}
+
+template <typename F> static void do_benchmark(benchmark::State &state, F f) {
+  const auto size = static_cast<int>(state.range(0));
+  std::vector<int> lhs(static_cast<size_t>(size));
+  std::vector<int> rhs(static_cast<size_t>(size));
+  for (int index = 0; index != size; ++index) {
+    lhs[static_cast<size_t>(index)] = index % 1000;
+    rhs[static_cast<size_t>(index)] = index % 7;
+  }
+
+  const bench::allocation_counter allocations;
+  for (auto _ : state) {
+    const auto total = f(lhs, rhs);
+    bench::do_not_optimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  allocations.report(state);
+}
+
+#define ZIP_BENCHMARK(func)                                                    \
+  BENCHMARK_CAPTURE(do_benchmark, func, func)->Range(1 << 10, 1 << 24);
+
+ZIP_BENCHMARK(dot_for_loop)
+ZIP_BENCHMARK(dot_eager_zip)
+ZIP_BENCHMARK(dot_zip)
+ZIP_BENCHMARK(dot_zip_with)
+
+BENCHMARK_MAIN();
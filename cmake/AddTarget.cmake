@@ -25,7 +25,9 @@ function(add_ranges_test name)
     return()
   endif()
 
-  target_link_libraries(${name} Catch2::Catch2)
+  # some of the tested algorithms run on a thread pool
+  find_package(Threads REQUIRED)
+  target_link_libraries(${name} Catch2::Catch2 Threads::Threads)
       
   include(Catch)
   catch_discover_tests(${name}
@@ -44,7 +46,65 @@ function(add_ranges_example name)
   add_range_target(${name} ${ARGN})
 endfunction()
 
+# add_ranges_benchmark(<name> [BACKENDS <backend>...] <sources>...)
+# builds <name>_<backend> for each of the backends, all the available ones by
+# default. backends which are not available are skipped.
 function(add_ranges_benchmark name)
-  add_range_target(${name} range-v3 ${ARGN})
-  target_link_libraries(${name} benchmark::benchmark)
+  cmake_parse_arguments(ARG "" "" "BACKENDS" ${ARGN})
+  if(NOT ARG_BACKENDS)
+    set(ARG_BACKENDS range-v3 stl2 nanorange::nanorange std-ranges)
+  endif()
+
+  foreach(rangeLib ${ARG_BACKENDS})
+    if(NOT TARGET ${rangeLib})
+      continue()
+    endif()
+    string(REGEX REPLACE ".*::" "" backend ${rangeLib})
+    string(REPLACE "-" "_" backend ${backend})
+    set(target ${name}_${backend})
+
+    add_range_target(${target} ${rangeLib} ${ARG_UNPARSED_ARGUMENTS})
+    target_link_libraries(${target} benchmark::benchmark)
+    if(BENCHMARK_NATIVE_ARCH)
+      target_compile_options(${target} PRIVATE
+        $<IF:$<CXX_COMPILER_ID:MSVC>,/arch:AVX2,-march=native>)
+    endif()
+    set_target_properties(${target} PROPERTIES
+      RANGES_BENCHMARK ${name}
+      RANGES_BACKEND ${backend})
+    set_property(GLOBAL APPEND PROPERTY RANGES_BENCHMARK_TARGETS ${target})
+  endforeach()
+endfunction()
+
+# adds a benchmark_report target which runs every benchmark target and prints
+# a comparison of the backends
+function(add_ranges_benchmark_report)
+  find_program(PYTHON_EXECUTABLE NAMES python3 python)
+  if(NOT PYTHON_EXECUTABLE)
+    message(STATUS "Python not found, benchmark_report is not available")
+    return()
+  endif()
+
+  separate_arguments(reportArgs UNIX_COMMAND "${BENCHMARK_REPORT_ARGS}")
+  set(outputDir ${CMAKE_BINARY_DIR}/benchmark_results)
+  set(commands COMMAND ${CMAKE_COMMAND} -E make_directory ${outputDir})
+  get_property(targets GLOBAL PROPERTY RANGES_BENCHMARK_TARGETS)
+  foreach(target ${targets})
+    get_target_property(benchmark ${target} RANGES_BENCHMARK)
+    get_target_property(backend ${target} RANGES_BACKEND)
+    list(APPEND commands
+      COMMAND $<TARGET_FILE:${target}>
+        --benchmark_out=${outputDir}/${benchmark}.${backend}.json
+        --benchmark_out_format=json
+        ${reportArgs})
+  endforeach()
+
+  add_custom_target(benchmark_report
+    ${commands}
+    COMMAND ${PYTHON_EXECUTABLE}
+      ${CMAKE_SOURCE_DIR}/benchmarks/compare_backends.py ${outputDir}
+    DEPENDS ${targets}
+    USES_TERMINAL
+    VERBATIM
+    COMMENT "Comparing ranges backends")
 endfunction()
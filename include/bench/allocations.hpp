@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+// counts the allocations made through the global allocation functions, which
+// benchmarks/allocations.cpp replaces: link it into the benchmarks which
+// include this header.
+
+namespace bench {
+
+struct allocation_stats {
+  int64_t allocations = 0;
+  int64_t bytes       = 0;
+};
+
+namespace detail {
+inline std::atomic<int64_t> allocations{0};
+inline std::atomic<int64_t> allocated_bytes{0};
+
+} // namespace detail
+
+// allocations made by the whole process so far
+inline allocation_stats allocations() noexcept {
+  return {detail::allocations.load(std::memory_order_relaxed),
+          detail::allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+// reports the allocations made between its construction and report() as
+// per iteration counters
+class allocation_counter {
+public:
+  allocation_counter() noexcept : m_start{allocations()} {}
+
+  void report(benchmark::State &state) const {
+    const auto end                = allocations();
+    state.counters["allocations"] = benchmark::Counter(
+      static_cast<double>(end.allocations - m_start.allocations),
+      benchmark::Counter::kAvgIterations);
+    state.counters["allocated_bytes"] =
+      benchmark::Counter(static_cast<double>(end.bytes - m_start.bytes),
+                         benchmark::Counter::kAvgIterations,
+                         benchmark::Counter::OneK::kIs1024);
+  }
+
+private:
+  allocation_stats m_start;
+};
+
+} // namespace bench
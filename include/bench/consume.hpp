@@ -0,0 +1,46 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <type_traits>
+#ifdef USE_RANGE_V3
+#include <range/v3/range/concepts.hpp>
+#elif defined(USE_STD_RANGES)
+#include <ranges>
+#elif defined(USE_NANORANGE)
+#include <nanorange.hpp>
+#else
+#include <experimental/ranges/ranges>
+#endif
+
+namespace bench {
+
+namespace detail {
+#ifdef USE_RANGE_V3
+template <typename T> constexpr bool is_view = ranges::view_<T>;
+#elif defined(USE_STD_RANGES)
+template <typename T> constexpr bool is_view = std::ranges::view<T>;
+#elif defined(USE_NANORANGE)
+template <typename T> constexpr bool is_view = nano::ranges::view<T>;
+#else
+template <typename T>
+constexpr bool is_view = std::experimental::ranges::view<T>;
+#endif
+} // namespace detail
+
+// drains a range, lazy or not, so that all of its elements are computed
+// inside the timed region
+template <typename Rng> void consume(Rng &&rng) {
+  for (auto &&element : rng) {
+    benchmark::DoNotOptimize(element);
+  }
+}
+
+// same as benchmark::DoNotOptimize but refuses views: keeping a view alive
+// does not evaluate any of its elements
+template <typename T> void do_not_optimize(const T &value) {
+  static_assert(!detail::is_view<std::remove_cv_t<T>>,
+                "benchmarked code returned an unevaluated view, drain it "
+                "with bench::consume");
+  benchmark::DoNotOptimize(value);
+}
+
+} // namespace bench
@@ -0,0 +1,215 @@
+#pragma once
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <unistd.h>
+// macOS has the headers, but no posix_fadvise
+#if defined(_POSIX_ADVISORY_INFO) && _POSIX_ADVISORY_INFO > 0
+#define BENCH_HAS_FADVISE 1
+#endif
+#endif
+
+namespace bench {
+
+enum class line_lengths : int64_t { fixed, uniform, skewed };
+
+inline const char *to_string(line_lengths lengths) {
+  switch (lengths) {
+    case line_lengths::fixed: return "fixed";
+    case line_lengths::uniform: return "uniform";
+    case line_lengths::skewed: return "skewed";
+  }
+  return "unknown";
+}
+
+// writes a deterministic set of text files into a temporary directory.
+// benchmark arguments are:
+// 0. number of files
+// 1. size of each file in bytes
+// 2. line length distribution, see line_lengths
+// 3. whether to drop the files from the page cache before every iteration
+class corpus_fixture : public benchmark::Fixture {
+public:
+  void SetUp(const benchmark::State &state) override {
+    const auto file_count = state.range(0);
+    m_file_size           = state.range(1);
+    m_lengths             = static_cast<line_lengths>(state.range(2));
+    m_cold                = state.range(3) != 0;
+
+    m_directory = std::filesystem::temp_directory_path()
+                  / ("ranges_corpus_" + std::to_string(file_count) + "_"
+                     + std::to_string(m_file_size) + "_" + to_string(m_lengths));
+
+    m_files.clear();
+    for (int64_t index = 0; index != file_count; ++index) {
+      m_files.push_back((m_directory / (std::to_string(index) + ".txt")).string());
+    }
+
+    // the benchmark library calls SetUp for every batch of iterations, only
+    // write each corpus once per process
+    auto &cache = corpus_cache::instance();
+    if (const auto it = cache.lines.find(m_directory); it != cache.lines.end()) {
+      m_lines = it->second;
+      return;
+    }
+    std::filesystem::create_directories(m_directory);
+    std::mt19937_64 gen;
+    m_lines = 0;
+    for (const auto &file : m_files) {
+      m_lines += write_file(file, gen);
+    }
+    cache.lines.emplace(m_directory, m_lines);
+  }
+
+  const std::vector<std::string> &files() const noexcept { return m_files; }
+
+  // total number of lines in the corpus
+  int64_t lines() const noexcept { return m_lines; }
+
+  // checks the line counts of every file against the corpus, call once
+  // outside of the timed loop
+  template <typename Rng>
+  void check_lines(benchmark::State &state, Rng &&counts) const {
+    int64_t total = 0;
+    for (auto &&count : counts) {
+      total += static_cast<int64_t>(count);
+    }
+    if (total != m_lines) {
+      state.SkipWithError(("counted " + std::to_string(total) + " lines out of "
+                           + std::to_string(m_lines))
+                            .c_str());
+    }
+  }
+
+  int64_t bytes() const noexcept {
+    return m_file_size * static_cast<int64_t>(m_files.size());
+  }
+
+  // call at the beginning of each iteration
+  void prepare(benchmark::State &state) const {
+    if (!m_cold) {
+      return;
+    }
+    state.PauseTiming();
+#ifdef BENCH_HAS_FADVISE
+    for (const auto &file : m_files) {
+      const int fd = ::open(file.c_str(), O_RDONLY);
+      if (fd < 0) {
+        state.SkipWithError(("cannot open " + file).c_str());
+        break;
+      }
+      ::fdatasync(fd);
+      ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      ::close(fd);
+    }
+#endif
+    state.ResumeTiming();
+  }
+
+  // reports throughput and the corpus shape
+  void report(benchmark::State &state) const {
+    state.SetBytesProcessed(state.iterations() * bytes());
+    state.SetItemsProcessed(state.iterations()
+                            * static_cast<int64_t>(m_files.size()));
+    state.SetLabel(std::string{to_string(m_lengths)}
+                   + (m_cold ? "/cold" : "/warm"));
+  }
+
+  // registers a typical matrix of corpora with a benchmark, keeping each
+  // corpus below 256MiB
+  static void arguments(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"files", "bytes", "lengths", "cold"});
+    for (const int64_t files : {1, 64, 4096}) {
+      for (const int64_t bytes : {4 << 10, 1 << 20, 64 << 20}) {
+        if (files * bytes > (int64_t{1} << 28)) {
+          continue;
+        }
+        for (const auto lengths :
+             {line_lengths::fixed, line_lengths::uniform,
+              line_lengths::skewed}) {
+#ifdef BENCH_HAS_FADVISE
+          for (const int64_t cold : {0, 1}) {
+#else
+          for (const int64_t cold : {0}) {
+#endif
+            b->Args({files, bytes, static_cast<int64_t>(lengths), cold});
+          }
+        }
+      }
+    }
+  }
+
+private:
+  // removes the generated corpora when the process exits
+  struct corpus_cache {
+    static corpus_cache &instance() {
+      static corpus_cache cache;
+      return cache;
+    }
+
+    ~corpus_cache() {
+      for (const auto &entry : lines) {
+        std::error_code ec;
+        std::filesystem::remove_all(entry.first, ec);
+      }
+    }
+
+    std::map<std::filesystem::path, int64_t> lines;
+  };
+
+  template <typename Gen>
+  int64_t next_line_length(Gen &gen) const {
+    switch (m_lengths) {
+      case line_lengths::fixed: return 80;
+      case line_lengths::uniform:
+        return std::uniform_int_distribution<int64_t>{0, 160}(gen);
+      case line_lengths::skewed:
+        // mostly short lines with a long tail, like log files
+        return std::min<int64_t>(
+          static_cast<int64_t>(std::lognormal_distribution<>{3.5, 1.2}(gen)),
+          1 << 16);
+    }
+    return 80;
+  }
+
+  template <typename Gen>
+  int64_t write_file(const std::string &path, Gen &gen) const {
+    std::string contents;
+    contents.reserve(static_cast<size_t>(m_file_size));
+    std::uniform_int_distribution<int> printable{' ', '~'};
+    int64_t lines = 0;
+    while (static_cast<int64_t>(contents.size()) < m_file_size) {
+      const auto length = std::min(next_line_length(gen),
+                                   m_file_size
+                                     - static_cast<int64_t>(contents.size()));
+      for (int64_t i = 0; i + 1 < length; ++i) {
+        contents.push_back(static_cast<char>(printable(gen)));
+      }
+      if (length > 0) {
+        contents.push_back('\n');
+        ++lines;
+      }
+    }
+    std::ofstream{path, std::ios::binary}.write(
+      contents.data(), static_cast<std::streamsize>(contents.size()));
+    return lines;
+  }
+
+  std::filesystem::path m_directory;
+  std::vector<std::string> m_files;
+  int64_t m_file_size    = 0;
+  int64_t m_lines        = 0;
+  line_lengths m_lengths = line_lengths::fixed;
+  bool m_cold            = false;
+};
+
+} // namespace bench
@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+enum class distribution : int64_t {
+  random,
+  sorted,
+  reversed,
+  few_unique,
+  organ_pipe,
+  k_sorted
+};
+
+inline const char *to_string(distribution d) {
+  switch (d) {
+    case distribution::random: return "random";
+    case distribution::sorted: return "sorted";
+    case distribution::reversed: return "reversed";
+    case distribution::few_unique: return "few_unique";
+    case distribution::organ_pipe: return "organ_pipe";
+    case distribution::k_sorted: return "k_sorted";
+  }
+  return "unknown";
+}
+
+namespace detail {
+// maps ranks to keys, preserving their order
+template <typename T> T make_key(int64_t rank) { return static_cast<T>(rank); }
+
+template <> inline double make_key<double>(int64_t rank) {
+  return static_cast<double>(rank) * 0.5 - 1e6;
+}
+
+template <> inline std::string make_key<std::string>(int64_t rank) {
+  // a common prefix makes comparisons look past the first characters
+  auto digits = std::to_string(rank);
+  return "key-" + std::string(12 - std::min<size_t>(digits.size(), 12), '0')
+         + digits;
+}
+} // namespace detail
+
+// generates the input of a sorting benchmark and restores it before every
+// iteration, outside of the timed region, so that no iteration sorts the
+// output of the previous one.
+// benchmark arguments are:
+// 0. number of elements
+// 1. key distribution, see distribution
+template <typename T> class sort_fixture : public benchmark::Fixture {
+public:
+  void SetUp(const benchmark::State &state) override {
+    const auto size = state.range(0);
+    m_distribution  = static_cast<distribution>(state.range(1));
+
+    std::mt19937_64 gen;
+    m_input.clear();
+    m_input.reserve(static_cast<size_t>(size));
+    for (int64_t index = 0; index != size; ++index) {
+      m_input.push_back(detail::make_key<T>(rank(index, size, gen)));
+    }
+  }
+
+  const std::vector<T> &input() const noexcept { return m_input; }
+
+  // call at the beginning of each iteration, replaces the contents of
+  // `container` with a copy of the input
+  template <typename Container>
+  void restore(benchmark::State &state, Container &container) const {
+    state.PauseTiming();
+    container.assign(m_input.begin(), m_input.end());
+    state.ResumeTiming();
+  }
+
+  void report(benchmark::State &state) const {
+    state.SetItemsProcessed(state.iterations()
+                            * static_cast<int64_t>(m_input.size()));
+    state.SetLabel(to_string(m_distribution));
+  }
+
+  // registers every distribution for sizes from 8 to MaxSize, by a factor of 8
+  template <int64_t MaxSize = (8 << 11)>
+  static void arguments(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"size", "distribution"});
+    for (int64_t size = 8;; size = std::min(size * 8, MaxSize)) {
+      for (const auto d :
+           {distribution::random, distribution::sorted, distribution::reversed,
+            distribution::few_unique, distribution::organ_pipe,
+            distribution::k_sorted}) {
+        b->Args({size, static_cast<int64_t>(d)});
+      }
+      if (size == MaxSize) {
+        break;
+      }
+    }
+  }
+
+private:
+  template <typename Gen>
+  int64_t rank(int64_t index, int64_t size, Gen &gen) const {
+    switch (m_distribution) {
+      case distribution::random:
+        return std::uniform_int_distribution<int64_t>{0, size - 1}(gen);
+      case distribution::sorted: return index;
+      case distribution::reversed: return size - 1 - index;
+      case distribution::few_unique:
+        return std::uniform_int_distribution<int64_t>{0, 15}(gen);
+      case distribution::organ_pipe:
+        // ascending then descending
+        return std::min(index, size - 1 - index);
+      case distribution::k_sorted:
+        // nearly sorted, every key is at most 32 ranks away from its index
+        return index + std::uniform_int_distribution<int64_t>{0, 32}(gen);
+    }
+    return index;
+  }
+
+  std::vector<T> m_input;
+  distribution m_distribution = distribution::random;
+};
+
+} // namespace bench
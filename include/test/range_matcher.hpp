@@ -1,7 +1,7 @@
 #ifdef USE_RANGE_V3
-#include <range/v3/algorithm/mismatch.hpp>
-#include <range/v3/view/common.hpp>
+#include <range/v3/range/concepts.hpp>
 #include <range/v3/view/ref.hpp>
+#include <range/v3/view/subrange.hpp>
 #elif defined(USE_NANORANGE)
 #include <nanorange.hpp>
 namespace ranges = nano::ranges;
@@ -11,9 +11,45 @@ namespace ranges = nano::ranges;
 namespace ranges = __stl2;
 #endif
 #include <utility/missing_utilities.hpp>
+#include <cstddef>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <catch2/catch.hpp>
 
+namespace range_matcher_detail {
+  // input ranges are only iterable when not const, and the expected range
+  // of a matcher is iterated from its const match
+  template <typename T> struct holder { mutable T value; };
+  template <typename T> struct holder<T &> { T &value; };
+
+  inline std::string to_string(const std::vector<std::string> &elements) {
+    std::string result = "{ ";
+    for (std::size_t i = 0; i != elements.size(); ++i)
+      result += (i == 0 ? "" : ", ") + elements[i];
+    return result + " }";
+  }
+
+  // only the first elements: the ranges compared by check_equal can be huge,
+  // and the context of a difference is in the description of RangeMatcher.
+  // input ranges were consumed by the comparison.
+  template <typename R> std::string first_elements(const R &rng) {
+    constexpr std::size_t max_elements = 16;
+    if constexpr (!ranges::forward_range<const R>) {
+      return "{ input range }";
+    } else {
+      std::vector<std::string> elements;
+      auto first = ranges::begin(rng);
+      for (; first != ranges::end(rng) && elements.size() != max_elements;
+           ++first)
+        elements.push_back(::Catch::Detail::stringify(*first));
+      if (first != ranges::end(rng))
+        elements.push_back("...");
+      return to_string(elements);
+    }
+  }
+} // namespace range_matcher_detail
+
 namespace Catch {
   // namespace Detail {
   //   template <typename T>
@@ -38,68 +74,115 @@ namespace Catch {
   {};
   
   template <typename I, typename S, ranges::subrange_kind K> struct StringMaker<ranges::subrange<I, S, K>> {
-    static std::string convert(ranges::subrange<I, S, K> view) {
-      return rangeToString(view | ranges::views::common);
+    static std::string convert(const ranges::subrange<I, S, K> &view) {
+      return range_matcher_detail::first_elements(view);
+    }
+  };
+
+  template <typename R>
+  struct is_range<ranges::ref_view<R>> : std::false_type
+  {};
+
+  template <typename R> struct StringMaker<ranges::ref_view<R>> {
+    static std::string convert(const ranges::ref_view<R> &view) {
+      return range_matcher_detail::first_elements(view);
     }
   };
 } // namespace Catch
 
+// compares both ranges in a single pass, stopping at the first difference,
+// so that neither needs to be sized or forward. the description only shows
+// `context` elements on both sides of the difference, and none before it for
+// input ranges, whose elements are gone once read. input ranges can only be
+// matched once.
 template <typename LHS, typename RHS>
 class RangeMatcher : public Catch::MatcherBase<LHS> {
 public:
-  RangeMatcher(RHS &&rhs) : m_rhs{std::forward<RHS>(rhs)} {}
+  static constexpr std::ptrdiff_t context = 3;
 
-  bool match(const LHS &lhs) const override { return match_impl(lhs); }
+  RangeMatcher(RHS &&rhs) : m_rhs{std::forward<RHS>(rhs)} {}
 
-  template <typename R>
-  bool CPP_fun(match_impl)(R lhs)(const requires ranges::range<R>) {
+  bool match(const LHS &lhs) const override {
     using namespace ranges;
     using namespace std::string_literals;
     using Catch::Detail::stringify;
 
-    if (distance(lhs) != distance(m_rhs)) {
-      m_message = "of lengths mistmatch";
-      return false;
+    m_message.clear();
+    auto &rhs = m_rhs.value;
+    auto l = begin(lhs);
+    auto r = begin(rhs);
+    auto l_first = context_first(l);
+    auto r_first = context_first(r);
+    std::ptrdiff_t index = 0;
+    for (; l != end(lhs) && r != end(rhs); ++l, ++r, ++index) {
+      if (!equal(*l, *r)) {
+        m_message = "at index "s + stringify(index) + ": " + stringify(*l)
+                    + " != " + stringify(*r);
+        break;
+      }
+      if constexpr (forward_iterator<decltype(l)>)
+        if (index >= context)
+          ++l_first;
+      if constexpr (forward_iterator<decltype(r)>)
+        if (index >= context)
+          ++r_first;
     }
-
-    if (auto [l, r] = mismatch(lhs); l != end(lhs)) {
-      m_message = "at index "s + stringify(distance(begin(lhs), l)) + ": "
-                  + stringify(*l) + " != " + stringify(*r);
-      return false;
+    if (m_message.empty()) {
+      if (l == end(lhs) && r == end(rhs))
+        return true;
+      m_message = "of lengths mismatch: "s
+                  + (l == end(lhs) ? "actual" : "expected")
+                  + " range ends at index " + stringify(index);
     }
-
-    return true;
+    m_message +=
+      "\nactual:   " + window(l_first, std::move(l), end(lhs), index)
+      + "\nexpected: " + window(r_first, std::move(r), end(rhs), index);
+    return false;
   }
 
-  template <typename R>
-  bool CPP_fun(match_impl)(const ranges::ref_view<R> &r)(
-    const requires ranges::range<R> && (!std::is_array<R>::value)) {
-    return match_impl(r.base());
+  std::string describe() const override {
+    return "not equal\nbecause\n" + m_message;
   }
 
-  template <typename L = LHS>
-  auto CPP_fun(mismatch)(L &&lhs)(
-    const requires std::is_floating_point_v<ranges::range_value_t<L>>) {
-    return ranges::mismatch(std::forward<L>(lhs), m_rhs,
-                            [](auto l, auto r) { return l == Approx(r); });
+private:
+  template <typename L, typename R>
+  static bool equal(L &&l, R &&r) {
+    if constexpr (std::is_floating_point_v<ranges::range_value_t<LHS>>)
+      return l == Approx(r);
+    else
+      return l == r;
   }
 
-  template <typename L = LHS>
-  auto CPP_fun(mismatch)(L &&lhs)(
-    const requires !std::is_floating_point_v<ranges::range_value_t<L>>) {
-    return ranges::mismatch(std::forward<L>(lhs), m_rhs);
+  // the first element of the context of `it`, which only forward ranges can
+  // keep up with
+  template <typename I> static auto context_first(const I &it) {
+    if constexpr (ranges::forward_iterator<I>)
+      return it;
+    else
+      return nullptr;
   }
 
-  std::string describe() const override {
-    using namespace ranges;
-    auto common = m_rhs | views::common;
-    return "not equal\n"
-           + Catch::Detail::rangeToString(begin(common), end(common))
-           + "\nbecause\n" + m_message;
+  // the elements from `first` to `context` elements after `it`, which is at
+  // `index`
+  template <typename F, typename I, typename S>
+  static std::string window(F first, I it, S last, std::ptrdiff_t index) {
+    std::vector<std::string> elements;
+    const bool skipped =
+      ranges::forward_iterator<I> ? index > context : index > 0;
+    if (skipped)
+      elements.push_back("...");
+    if constexpr (ranges::forward_iterator<I>)
+      for (; first != it; ++first)
+        elements.push_back(::Catch::Detail::stringify(*first));
+    for (std::ptrdiff_t after = 0; it != last && after <= context;
+         ++it, ++after)
+      elements.push_back(::Catch::Detail::stringify(*it));
+    if (it != last)
+      elements.push_back("...");
+    return range_matcher_detail::to_string(elements);
   }
 
-private:
-  RHS m_rhs;
+  range_matcher_detail::holder<RHS> m_rhs;
   mutable std::string m_message;
 };
 
@@ -107,30 +190,17 @@ template <typename LHS, typename RHS> RangeMatcher<LHS, RHS> Equals(RHS &&rhs) {
   return {std::forward<RHS>(rhs)};
 }
 
-template <typename LHS, typename RHS>
-void CPP_fun(check_equal)(const LHS &lhs, RHS &&rhs, bool /*force_call*/ = false)(
-  requires ranges::forward_range<LHS> && ranges::forward_range<RHS> && ranges::range<const LHS>) {
-  REQUIRE_THAT(lhs,
-               Equals<decltype(lhs)>(std::forward<RHS>(rhs)));
-}
-
+// the actual range is matched through a reference, which does not copy input
+// ranges and is iterable from the const match
 template <typename LHS, typename RHS>
 void CPP_fun(check_equal)(LHS &&lhs, RHS &&rhs, bool /*force_call*/ = false)(
-  requires ranges::forward_range<LHS> &&ranges::forward_range<RHS>) {
+  requires ranges::range<LHS> && ranges::range<RHS>) {
   // intentionally not forwarding lhs to enforce it being an lvalue reference
-  REQUIRE_THAT(ranges::subrange(lhs),
-               Equals<decltype(ranges::subrange(lhs))>(std::forward<RHS>(rhs)));
-}
-
-template <typename LHS, typename RHS>
-void CPP_fun(check_equal)(LHS &&lhs, RHS &&rhs, bool /*force_call*/ = false)(
-  requires !ranges::forward_range<LHS> || !ranges::forward_range<RHS>) {
-  using namespace ranges;
-  REQUIRE_THAT(to_vector(std::forward<LHS>(lhs)),
-               Equals<decltype(to_vector(std::forward<LHS>(lhs)))>(rhs));
+  REQUIRE_THAT(ranges::ref_view(lhs),
+               Equals<decltype(ranges::ref_view(lhs))>(std::forward<RHS>(rhs)));
 }
 
 template <typename LHS, typename T>
 void check_equal(LHS &&lhs, std::initializer_list<T> rhs) {
   check_equal(std::forward<LHS>(lhs), rhs, true);
-}
\ No newline at end of file
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "utility/simd.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace utility {
+
+namespace detail::c_str {
+template <typename T>
+constexpr bool is_char = std::is_same_v<T, char> || std::is_same_v<T, wchar_t>
+                         || std::is_same_v<T, char8_t>
+                         || std::is_same_v<T, char16_t>
+                         || std::is_same_v<T, char32_t>;
+
+// std::strlen for any character type, vectorized for narrow characters
+template <typename Char> std::size_t length(const Char *str) {
+  if constexpr (sizeof(Char) == 1) {
+    return simd::length(reinterpret_cast<const char *>(str));
+  } else {
+    return std::char_traits<Char>::length(str);
+  }
+}
+} // namespace detail::c_str
+
+namespace views {
+
+// a null terminated string as a std::basic_string_view, without its
+// terminator. unlike ranges::views::c_str, which checks every character
+// against the terminator while iterating, the length of a pointer is
+// measured once up front, so the view is sized and contiguous: distance is
+// constant time and copies into containers are reserved and memcpy'd.
+struct c_str_fn {
+  // an array is assumed to be a literal, ending with its only terminator
+  template <typename Char, std::size_t N,
+            typename = std::enable_if_t<detail::c_str::is_char<Char>>>
+  std::basic_string_view<Char> operator()(const Char (&str)[N]) const {
+    return {str, N - 1};
+  }
+
+  // taken by forwarding reference, so that arrays never decay to pointers
+  // and choose this overload
+  template <typename Ptr,
+            typename Char = std::remove_cv_t<
+              std::remove_pointer_t<std::remove_cvref_t<Ptr>>>,
+            typename = std::enable_if_t<
+              std::is_pointer_v<std::remove_cvref_t<Ptr>>
+              && detail::c_str::is_char<Char>>>
+  std::basic_string_view<Char> operator()(Ptr &&str) const {
+    return {str, detail::c_str::length<Char>(str)};
+  }
+};
+
+inline constexpr c_str_fn c_str;
+
+} // namespace views
+
+} // namespace utility
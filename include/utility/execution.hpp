@@ -0,0 +1,34 @@
+#pragma once
+#include "utility/thread_pool.hpp"
+
+namespace utility::execution {
+
+struct sequenced_policy {};
+
+// runs on `pool`, or on a pool shared by the whole process when none is given
+class parallel_policy {
+public:
+  constexpr parallel_policy() = default;
+
+  constexpr parallel_policy on(thread_pool &pool) const {
+    parallel_policy policy;
+    policy.m_pool = &pool;
+    return policy;
+  }
+
+  thread_pool &pool() const {
+    if (m_pool) {
+      return *m_pool;
+    }
+    static thread_pool shared;
+    return shared;
+  }
+
+private:
+  thread_pool *m_pool = nullptr;
+};
+
+inline constexpr sequenced_policy seq;
+inline constexpr parallel_policy par;
+
+} // namespace utility::execution
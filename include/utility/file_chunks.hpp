@@ -0,0 +1,165 @@
+#pragma once
+#include "utility/mapped_file.hpp"
+#include "utility/ranges.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace utility {
+
+using byte_span = std::span<const std::byte>;
+
+namespace detail {
+inline constexpr std::size_t buffer_alignment = 4096;
+
+struct aligned_delete {
+  void operator()(std::byte *p) const {
+    ::operator delete[](p, std::align_val_t{buffer_alignment});
+  }
+};
+
+using aligned_buffer = std::unique_ptr<std::byte[], aligned_delete>;
+
+inline aligned_buffer make_aligned_buffer(std::size_t size) {
+  return aligned_buffer{static_cast<std::byte *>(
+    ::operator new[](size, std::align_val_t{buffer_alignment}))};
+}
+} // namespace detail
+
+// input range over the blocks produced by a `Source`, which is constructed
+// from the view arguments and provides `open()`, called once by begin(), and
+// `next()`, which returns the next block or an empty one at the end. a block
+// is only valid until the iterator is incremented.
+template <typename Source> class chunk_view : public ranges::view_base {
+  struct state {
+    template <typename... Args>
+    explicit state(Args &&... args) : source{std::forward<Args>(args)...} {}
+
+    Source source;
+    byte_span current;
+  };
+
+public:
+  struct sentinel {};
+
+  class iterator {
+  public:
+    using iterator_concept  = std::input_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = byte_span;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = byte_span;
+
+    iterator() = default;
+
+    reference operator*() const { return m_state->current; }
+
+    iterator &operator++() {
+      m_state->current = m_state->source.next();
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator &it, sentinel) {
+      return it.m_state->current.empty();
+    }
+    friend bool operator==(sentinel s, const iterator &it) { return it == s; }
+    friend bool operator!=(const iterator &it, sentinel s) { return !(it == s); }
+    friend bool operator!=(sentinel s, const iterator &it) { return !(it == s); }
+
+  private:
+    friend chunk_view;
+    explicit iterator(state *s) : m_state{s} {}
+
+    state *m_state = nullptr;
+  };
+
+  chunk_view() = default;
+
+  template <typename... Args>
+  explicit chunk_view(std::in_place_t, Args &&... args) :
+    m_state{std::make_shared<state>(std::forward<Args>(args)...)} {}
+
+  // single pass: the source is opened by the first call
+  iterator begin() {
+    m_state->source.open();
+    m_state->current = m_state->source.next();
+    return iterator{m_state.get()};
+  }
+
+  sentinel end() const { return {}; }
+
+private:
+  std::shared_ptr<state> m_state;
+};
+
+namespace detail {
+// blocks point straight into a memory mapping when the file can be mapped,
+// otherwise into a single page aligned buffer which is refilled for every
+// block. a file which cannot be opened is empty, a read which fails throws
+// std::system_error rather than ending the blocks early.
+class file_chunk_source {
+public:
+  file_chunk_source(std::string path, std::size_t chunk_size) :
+    m_path{std::move(path)}, m_chunk_size{std::max<std::size_t>(chunk_size, 1)} {}
+
+  void open() {
+    if (m_mapping = mapped_file{m_path}; !m_mapping) {
+      m_reader = file_reader{m_path};
+      m_buffer = make_aligned_buffer(m_chunk_size);
+    }
+    m_offset = 0;
+  }
+
+  byte_span next() {
+    if (m_mapping) {
+      const auto size = std::min(m_chunk_size, m_mapping.size() - m_offset);
+      const auto data =
+        reinterpret_cast<const std::byte *>(m_mapping.data()) + m_offset;
+      m_offset += size;
+      return {data, size};
+    }
+    const auto size = m_reader.read(m_buffer.get(), m_chunk_size);
+    if (m_reader.failed()) {
+      throw std::system_error{errno, std::generic_category(),
+                              "cannot read " + m_path};
+    }
+    return {m_buffer.get(), size};
+  }
+
+private:
+  std::string m_path;
+  std::size_t m_chunk_size;
+  mapped_file m_mapping;
+  std::size_t m_offset = 0;
+  file_reader m_reader;
+  aligned_buffer m_buffer;
+};
+} // namespace detail
+
+using file_chunks_view = chunk_view<detail::file_chunk_source>;
+
+namespace views {
+
+inline constexpr std::size_t default_chunk_size = 1 << 20;
+
+struct file_chunks_fn {
+  file_chunks_view operator()(std::string path,
+                              std::size_t chunk_size = default_chunk_size) const {
+    return file_chunks_view{std::in_place, std::move(path), chunk_size};
+  }
+};
+
+inline constexpr file_chunks_fn file_chunks;
+
+} // namespace views
+
+} // namespace utility
@@ -0,0 +1,26 @@
+#pragma once
+#include <functional>
+#include <utility>
+
+namespace utility {
+
+namespace detail {
+struct identity {
+  template <typename T> constexpr T &&operator()(T &&t) const noexcept {
+    return std::forward<T>(t);
+  }
+};
+
+// compares the projections of its arguments
+template <typename Comp, typename Proj> struct projected_compare {
+  template <typename T, typename U> bool operator()(T &&lhs, U &&rhs) const {
+    return std::invoke(comp, std::invoke(proj, std::forward<T>(lhs)),
+                       std::invoke(proj, std::forward<U>(rhs)));
+  }
+
+  Comp comp;
+  Proj proj;
+};
+} // namespace detail
+
+} // namespace utility
@@ -0,0 +1,120 @@
+#pragma once
+#include "utility/ranges.hpp"
+#include "utility/simd.hpp"
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+namespace utility {
+
+// forward range of the lines of a contiguous character buffer, without their
+// line terminators. a last line which is not terminated is still a line, an
+// empty buffer has no lines. lines refer to the buffer, nothing is copied.
+class lines_view : public ranges::view_base {
+public:
+  class iterator {
+  public:
+    using iterator_concept  = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::string_view;
+
+    iterator() = default;
+
+    reference operator*() const {
+      auto size = static_cast<std::size_t>(m_line_end - m_line);
+      // an unterminated last line has no "\r\n" terminator, its '\r' stays
+      if (m_strip_cr && m_line_end != m_end && size != 0
+          && m_line[size - 1] == '\r') {
+        --size;
+      }
+      return {m_line, size};
+    }
+
+    iterator &operator++() {
+      m_line = m_line_end == m_end ? m_end : m_line_end + 1;
+      find_line_end();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const iterator &lhs, const iterator &rhs) {
+      return lhs.m_line == rhs.m_line;
+    }
+    friend bool operator!=(const iterator &lhs, const iterator &rhs) {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend lines_view;
+
+    iterator(const char *line, const char *end, bool strip_cr) :
+      m_line{line}, m_end{end}, m_strip_cr{strip_cr} {
+      find_line_end();
+    }
+
+    void find_line_end() { m_line_end = simd::find(m_line, m_end, '\n'); }
+
+    const char *m_line     = nullptr;
+    const char *m_line_end = nullptr;
+    const char *m_end      = nullptr;
+    bool m_strip_cr        = false;
+  };
+
+  lines_view() = default;
+
+  // when `strip_cr` is set, a '\r' before the '\n' is dropped as well
+  explicit lines_view(std::string_view text, bool strip_cr = false) :
+    m_text{text}, m_strip_cr{strip_cr} {}
+
+  iterator begin() const {
+    return {m_text.data(), m_text.data() + m_text.size(), m_strip_cr};
+  }
+
+  iterator end() const {
+    const auto last = m_text.data() + m_text.size();
+    return {last, last, m_strip_cr};
+  }
+
+  bool empty() const noexcept { return m_text.empty(); }
+
+private:
+  std::string_view m_text;
+  bool m_strip_cr = false;
+};
+
+namespace views {
+
+struct lines_fn {
+  // anything with contiguous `data()` and `size()`: strings, string views,
+  // vectors of char, mapped files...
+  template <typename Text>
+  auto operator()(const Text &text, bool strip_cr = false) const
+    -> decltype(std::string_view{text.data(), text.size()}, lines_view{}) {
+    return lines_view{std::string_view{text.data(), text.size()}, strip_cr};
+  }
+
+  template <std::size_t N>
+  lines_view operator()(const char (&text)[N], bool strip_cr = false) const {
+    return lines_view{std::string_view{text, N - 1}, strip_cr};
+  }
+
+  template <typename Text>
+  friend auto operator|(const Text &text, lines_fn lines)
+    -> decltype(lines(text)) {
+    return lines(text);
+  }
+};
+
+inline constexpr lines_fn lines;
+
+} // namespace views
+
+} // namespace utility
@@ -0,0 +1,192 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define UTILITY_HAS_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// macOS has the headers, but no posix_fadvise
+#if defined(_POSIX_ADVISORY_INFO) && _POSIX_ADVISORY_INFO > 0
+#define UTILITY_HAS_FADVISE 1
+#endif
+#endif
+
+namespace utility {
+
+// read-only view of a whole file, memory mapped when the platform supports it.
+// a default constructed or moved-from object, as well as a file which cannot
+// be mapped (empty, a pipe, a special file...), converts to false.
+class mapped_file {
+public:
+  mapped_file() = default;
+
+  explicit mapped_file(const std::string &path) {
+#ifdef UTILITY_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      const auto size = static_cast<std::size_t>(st.st_size);
+      void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        ::madvise(addr, size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char *>(addr);
+        m_size = size;
+      }
+    }
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+#else
+    static_cast<void>(path);
+#endif
+  }
+
+  mapped_file(mapped_file &&other) noexcept :
+    m_data{std::exchange(other.m_data, nullptr)},
+    m_size{std::exchange(other.m_size, 0)} {}
+
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    mapped_file tmp{std::move(other)};
+    std::swap(m_data, tmp.m_data);
+    std::swap(m_size, tmp.m_size);
+    return *this;
+  }
+
+  ~mapped_file() {
+#ifdef UTILITY_HAS_MMAP
+    if (m_data) {
+      ::munmap(const_cast<char *>(m_data), m_size);
+    }
+#endif
+  }
+
+  const char *data() const noexcept { return m_data; }
+  std::size_t size() const noexcept { return m_size; }
+  const char *begin() const noexcept { return m_data; }
+  const char *end() const noexcept { return m_data + m_size; }
+
+  explicit operator bool() const noexcept { return m_data != nullptr; }
+
+private:
+  const char *m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+// sequential reader for files which cannot be mapped
+class file_reader {
+public:
+  file_reader() = default;
+
+  explicit file_reader(const std::string &path) {
+#ifdef UTILITY_HAS_MMAP
+    m_handle = ::open(path.c_str(), O_RDONLY);
+#ifdef UTILITY_HAS_FADVISE
+    if (m_handle >= 0) {
+      ::posix_fadvise(m_handle, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+#else
+    m_handle = std::fopen(path.c_str(), "rb");
+#endif
+  }
+
+  file_reader(file_reader &&other) noexcept :
+    m_handle{std::exchange(other.m_handle, invalid_handle)},
+    m_failed{std::exchange(other.m_failed, false)} {}
+
+  file_reader &operator=(file_reader &&other) noexcept {
+    file_reader tmp{std::move(other)};
+    std::swap(m_handle, tmp.m_handle);
+    std::swap(m_failed, tmp.m_failed);
+    return *this;
+  }
+
+  ~file_reader() {
+    if (*this) {
+#ifdef UTILITY_HAS_MMAP
+      ::close(m_handle);
+#else
+      std::fclose(m_handle);
+#endif
+    }
+  }
+
+  explicit operator bool() const noexcept { return m_handle != invalid_handle; }
+
+  // reads up to `size` bytes, returns the number of bytes read, 0 at the end
+  // of the file or on error, after which failed() is true. reads interrupted
+  // by a signal are retried.
+  std::size_t read(void *buffer, std::size_t size) {
+#ifdef UTILITY_HAS_MMAP
+    for (;;) {
+      const auto bytes = ::read(m_handle, buffer, size);
+      if (bytes >= 0) {
+        return static_cast<std::size_t>(bytes);
+      }
+      if (errno != EINTR) {
+        m_failed = true;
+        return 0;
+      }
+    }
+#else
+    const auto bytes = std::fread(buffer, 1, size, m_handle);
+    if (std::ferror(m_handle)) {
+      m_failed = true;
+    }
+    return bytes;
+#endif
+  }
+
+  bool failed() const noexcept { return m_failed; }
+
+private:
+#ifdef UTILITY_HAS_MMAP
+  using handle_type = int;
+  static constexpr handle_type invalid_handle = -1;
+#else
+  using handle_type = std::FILE *;
+  static constexpr handle_type invalid_handle = nullptr;
+#endif
+
+  handle_type m_handle = invalid_handle;
+  bool m_failed        = false;
+};
+
+// sequentially reads the file at `path` into `buffer`, calling `f(first, last)`
+// for every block read. returns false if the file could not be opened or read.
+template <typename F>
+bool read_blocks(const std::string &path, std::vector<char> &buffer, F &&f) {
+  file_reader file{path};
+  if (!file) {
+    return false;
+  }
+  while (const auto bytes = file.read(buffer.data(), buffer.size())) {
+    f(static_cast<const char *>(buffer.data()), buffer.data() + bytes);
+  }
+  return !file.failed();
+}
+
+// calls `f(first, last)` over the whole contents of the file at `path`, in a
+// single call when it can be memory mapped or block by block otherwise.
+// returns false if the file could not be opened or read.
+template <typename F>
+bool for_each_block(const std::string &path, F &&f,
+                    std::size_t buffer_size = 1 << 16) {
+  if (const mapped_file file{path}) {
+    f(file.begin(), file.end());
+    return true;
+  }
+  std::vector<char> buffer(buffer_size);
+  return read_blocks(path, buffer, std::forward<F>(f));
+}
+
+} // namespace utility
@@ -11,13 +11,28 @@ template <> struct is_char_type_<char8_t> : std::true_type {};
 #endif // _MSC_VER
 
 #else
+#include "utility/c_str.hpp"
+#include "utility/to_container.hpp"
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
 #ifdef USE_STL2
 #include <experimental/ranges/algorithm>
 #include <experimental/ranges/ranges>
+#include <functional>
 #include <vector>
 
 STL2_OPEN_NAMESPACE {
+#elif defined(USE_STD_RANGES)
+#include "utility/ranges.hpp"
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace ranges {
+  using std::back_inserter;
 #else
 #include <nanorange.hpp>
 
@@ -28,10 +43,10 @@ NANO_BEGIN_NAMESPACE
   template <range R> using range_value_t = ext::range_value_t<R>;
 #endif
 
+  // reserves for sized ranges and copies contiguous ranges at once, see
+  // utility::to_vector for allocators and size hints
   inline constexpr auto to_vector = [](auto &&rng) {
-    using Cont  = std::vector<range_value_t<decltype(rng)>>;
-    auto common = std::forward<decltype(rng)>(rng) | views::common;
-    return Cont{begin(common), end(common)};
+    return ::utility::to_vector(std::forward<decltype(rng)>(rng));
   };
 
   CPP_template(typename V)
@@ -40,6 +55,22 @@ NANO_BEGIN_NAMESPACE
     return tv(std::forward<V>(v));
   }
 
+#ifndef USE_NANORANGE
+  struct accumulate_fn {
+    template <typename Rng, typename T, typename Op = std::plus<>>
+    T operator()(Rng &&rng, T init, Op op = {}) const {
+      for (auto &&element : rng) {
+        init = op(std::move(init), std::forward<decltype(element)>(element));
+      }
+      return init;
+    }
+  };
+
+  inline constexpr accumulate_fn accumulate;
+#endif
+
+#ifndef USE_STD_RANGES
+  // std::ranges::views cannot be extended
   namespace views {
 
   namespace detail {
@@ -47,8 +78,343 @@ NANO_BEGIN_NAMESPACE
     template <typename Char, size_t N> auto operator()(Char (&sz)[N]) const {
       return subrange{&sz[0], &sz[N - 1]};
     }
+
+    // sized as well, see utility::views::c_str
+    CPP_template(typename Char)(
+      requires ::utility::detail::c_str::is_char<std::remove_const_t<Char>>)
+    auto operator()(Char *const &sz) const {
+      using char_type = std::remove_const_t<Char>;
+      return subrange{sz, sz + ::utility::detail::c_str::length<char_type>(sz)};
+    }
+  };
+
+  template <bool Const, typename R>
+  using maybe_const = std::conditional_t<Const, const R, R>;
+
+  // the reference type of zip_view, a pair of the references of both
+  // ranges. it converts from pairs of values and assigns through even when
+  // const, like the std::pair of C++23, which makes zip_view writable.
+  template <typename T1, typename T2> struct zip_pair : std::pair<T1, T2> {
+    using std::pair<T1, T2>::pair;
+
+    CPP_template(typename U1, typename U2)(
+      requires std::is_constructible_v<T1, U1 &>
+      && std::is_constructible_v<T2, U2 &>)
+    zip_pair(std::pair<U1, U2> &other) :
+      std::pair<T1, T2>{other.first, other.second} {}
+
+    zip_pair(const zip_pair &) = default;
+    zip_pair(zip_pair &&)      = default;
+
+    const zip_pair &operator=(const zip_pair &other) const {
+      return *this = static_cast<const std::pair<T1, T2> &>(other);
+    }
+
+    CPP_template(typename U1, typename U2)(
+      requires std::is_assignable_v<const T1 &, const U1 &>
+      && std::is_assignable_v<const T2 &, const U2 &>)
+    const zip_pair &operator=(const std::pair<U1, U2> &other) const {
+      this->first  = other.first;
+      this->second = other.second;
+      return *this;
+    }
+
+    CPP_template(typename U1, typename U2)(
+      requires std::is_assignable_v<const T1 &, U1>
+      && std::is_assignable_v<const T2 &, U2>)
+    const zip_pair &operator=(std::pair<U1, U2> &&other) const {
+      this->first  = std::forward<U1>(other.first);
+      this->second = std::forward<U2>(other.second);
+      return *this;
+    }
+
+    friend void CPP_fun(swap)(const zip_pair &lhs, const zip_pair &rhs)(
+      requires std::is_swappable_v<const T1 &>
+      && std::is_swappable_v<const T2 &>) {
+      using std::swap;
+      swap(lhs.first, rhs.first);
+      swap(lhs.second, rhs.second);
+    }
+  };
+
+  // the elements of two views in lockstep, as pairs of their references,
+  // until the end of the shortest one. random access, sized and common when
+  // both views are random access and sized.
+  template <typename R1, typename R2>
+  class zip_view : public view_interface<zip_view<R1, R2>> {
+    template <bool Const> class sentinel;
+
+    template <bool Const> class iterator {
+      using I1 = iterator_t<maybe_const<Const, R1>>;
+      using I2 = iterator_t<maybe_const<Const, R2>>;
+
+    public:
+      using iterator_concept = std::conditional_t<
+        random_access_range<maybe_const<Const, R1>>
+          && random_access_range<maybe_const<Const, R2>>,
+        std::random_access_iterator_tag,
+        std::conditional_t<
+          bidirectional_range<maybe_const<Const, R1>>
+            && bidirectional_range<maybe_const<Const, R2>>,
+          std::bidirectional_iterator_tag,
+          std::conditional_t<forward_range<maybe_const<Const, R1>>
+                               && forward_range<maybe_const<Const, R2>>,
+                             std::forward_iterator_tag,
+                             std::input_iterator_tag>>>;
+      // references are pairs returned by value
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::pair<iter_value_t<I1>, iter_value_t<I2>>;
+      using reference  = zip_pair<iter_reference_t<I1>, iter_reference_t<I2>>;
+      using difference_type =
+        std::common_type_t<iter_difference_t<I1>, iter_difference_t<I2>>;
+
+      iterator() = default;
+      iterator(I1 first, I2 second) :
+        m_first{std::move(first)}, m_second{std::move(second)} {}
+      CPP_member
+      CPP_fun(iterator)(iterator<!Const> other)(
+        requires Const && std::is_convertible_v<iterator_t<R1>, I1>
+        && std::is_convertible_v<iterator_t<R2>, I2>) :
+        m_first{std::move(other.m_first)},
+          m_second{std::move(other.m_second)} {}
+
+      reference operator*() const { return {*m_first, *m_second}; }
+
+      CPP_member
+      reference CPP_fun(operator[])(difference_type n)(
+        const requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return *(*this + n);
+      }
+
+      iterator &operator++() {
+        ++m_first;
+        ++m_second;
+        return *this;
+      }
+
+      auto operator++(int) {
+        if constexpr (std::is_same_v<iterator_concept,
+                                     std::input_iterator_tag>) {
+          ++*this;
+        } else {
+          auto copy = *this;
+          ++*this;
+          return copy;
+        }
+      }
+
+      CPP_member
+      iterator &CPP_fun(operator--)()(
+        requires bidirectional_range<maybe_const<Const, R1>>
+        && bidirectional_range<maybe_const<Const, R2>>) {
+        --m_first;
+        --m_second;
+        return *this;
+      }
+
+      CPP_member
+      iterator CPP_fun(operator--)(int)(
+        requires bidirectional_range<maybe_const<Const, R1>>
+        && bidirectional_range<maybe_const<Const, R2>>) {
+        auto copy = *this;
+        --*this;
+        return copy;
+      }
+
+      CPP_member
+      iterator &CPP_fun(operator+=)(difference_type n)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        m_first += static_cast<iter_difference_t<I1>>(n);
+        m_second += static_cast<iter_difference_t<I2>>(n);
+        return *this;
+      }
+
+      CPP_member
+      iterator &CPP_fun(operator-=)(difference_type n)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return *this += -n;
+      }
+
+      friend iterator CPP_fun(operator+)(iterator it, difference_type n)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return it += n;
+      }
+
+      friend iterator CPP_fun(operator+)(difference_type n, iterator it)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return it += n;
+      }
+
+      friend iterator CPP_fun(operator-)(iterator it, difference_type n)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return it -= n;
+      }
+
+      // both iterators always move together, comparing the first ones is
+      // enough
+      friend difference_type CPP_fun(operator-)(const iterator &lhs,
+                                                const iterator &rhs)(
+        requires sized_sentinel_for<I1, I1>) {
+        return static_cast<difference_type>(lhs.m_first - rhs.m_first);
+      }
+
+      friend bool CPP_fun(operator==)(const iterator &lhs, const iterator &rhs)(
+        requires equality_comparable<I1>) {
+        return lhs.m_first == rhs.m_first;
+      }
+
+      friend bool CPP_fun(operator!=)(const iterator &lhs, const iterator &rhs)(
+        requires equality_comparable<I1>) {
+        return !(lhs == rhs);
+      }
+
+      friend bool CPP_fun(operator<)(const iterator &lhs, const iterator &rhs)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return lhs.m_first < rhs.m_first;
+      }
+
+      friend bool CPP_fun(operator>)(const iterator &lhs, const iterator &rhs)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return rhs < lhs;
+      }
+
+      friend bool CPP_fun(operator<=)(const iterator &lhs, const iterator &rhs)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return !(rhs < lhs);
+      }
+
+      friend bool CPP_fun(operator>=)(const iterator &lhs, const iterator &rhs)(
+        requires random_access_range<maybe_const<Const, R1>>
+        && random_access_range<maybe_const<Const, R2>>) {
+        return !(lhs < rhs);
+      }
+
+      friend zip_pair<iter_rvalue_reference_t<I1>, iter_rvalue_reference_t<I2>>
+      iter_move(const iterator &it) {
+        return {ranges::iter_move(it.m_first), ranges::iter_move(it.m_second)};
+      }
+
+      // swaps the elements, the pairs of references are temporaries
+      friend void CPP_fun(iter_swap)(const iterator &lhs, const iterator &rhs)(
+        requires indirectly_swappable<I1> && indirectly_swappable<I2>) {
+        ranges::iter_swap(lhs.m_first, rhs.m_first);
+        ranges::iter_swap(lhs.m_second, rhs.m_second);
+      }
+
+    private:
+      friend class iterator<!Const>;
+      friend class sentinel<Const>;
+
+      I1 m_first{};
+      I2 m_second{};
+    };
+
+    template <bool Const> class sentinel {
+      using S1 = sentinel_t<maybe_const<Const, R1>>;
+      using S2 = sentinel_t<maybe_const<Const, R2>>;
+
+    public:
+      sentinel() = default;
+      sentinel(S1 first, S2 second) :
+        m_first{std::move(first)}, m_second{std::move(second)} {}
+
+      friend bool operator==(const iterator<Const> &it, const sentinel &s) {
+        return s.equal(it);
+      }
+      friend bool operator==(const sentinel &s, const iterator<Const> &it) {
+        return it == s;
+      }
+      friend bool operator!=(const iterator<Const> &it, const sentinel &s) {
+        return !(it == s);
+      }
+      friend bool operator!=(const sentinel &s, const iterator<Const> &it) {
+        return !(it == s);
+      }
+
+    private:
+      // the shortest range ends first
+      bool equal(const iterator<Const> &it) const {
+        return it.m_first == m_first || it.m_second == m_second;
+      }
+
+      S1 m_first{};
+      S2 m_second{};
+    };
+
+    template <bool Const> static constexpr bool is_common_random_access() {
+      return random_access_range<maybe_const<Const, R1>>
+             && random_access_range<maybe_const<Const, R2>>
+             && sized_range<maybe_const<Const, R1>>
+             && sized_range<maybe_const<Const, R2>>;
+    }
+
+    template <bool Const, typename Self> static auto make_end(Self &self) {
+      if constexpr (is_common_random_access<Const>()) {
+        return self.begin()
+               + static_cast<typename iterator<Const>::difference_type>(
+                 self.size());
+      } else {
+        return sentinel<Const>{ranges::end(self.m_first),
+                               ranges::end(self.m_second)};
+      }
+    }
+
+  public:
+    zip_view() = default;
+    zip_view(R1 first, R2 second) :
+      m_first{std::move(first)}, m_second{std::move(second)} {}
+
+    iterator<false> begin() {
+      return {ranges::begin(m_first), ranges::begin(m_second)};
+    }
+    CPP_member
+    iterator<true> CPP_fun(begin)()(
+      const requires range<const R1> && range<const R2>) {
+      return {ranges::begin(m_first), ranges::begin(m_second)};
+    }
+
+    auto end() { return make_end<false>(*this); }
+    CPP_member
+    auto CPP_fun(end)()(const requires range<const R1> && range<const R2>) {
+      return make_end<true>(*this);
+    }
+
+    CPP_member
+    auto CPP_fun(size)()(requires sized_range<R1> && sized_range<R2>) {
+      return size(m_first, m_second);
+    }
+    CPP_member
+    auto CPP_fun(size)()(
+      const requires sized_range<const R1> && sized_range<const R2>) {
+      return size(m_first, m_second);
+    }
+
+  private:
+    template <typename T1, typename T2>
+    static auto size(T1 &first, T2 &second) {
+      using size_type = std::common_type_t<decltype(ranges::size(first)),
+                                           decltype(ranges::size(second))>;
+      return std::min<size_type>(ranges::size(first), ranges::size(second));
+    }
+
+    R1 m_first{};
+    R2 m_second{};
   };
 
+  template <typename R1, typename R2>
+  zip_view(R1 &&, R2 &&)
+    -> zip_view<decltype(views::all(std::declval<R1>())),
+                decltype(views::all(std::declval<R2>()))>;
+
   } // namespace detail
 
   inline constexpr detail::c_str_fn c_str;
@@ -60,16 +426,16 @@ NANO_BEGIN_NAMESPACE
 #endif
 
   inline constexpr auto zip = [](auto &&rng1, auto &&rng2) {
-    std::vector<
-      std::pair<range_value_t<decltype(rng1)>, range_value_t<decltype(rng2)>>>
-      v;
-    ranges::transform(std::forward<decltype(rng1)>(rng1),
-                      std::forward<decltype(rng2)>(rng2),
-                      ranges::back_inserter(v), [](auto &&val1, auto &&val2) {
-                        return std::pair{std::forward<decltype(val1)>(val1),
-                                         std::forward<decltype(val2)>(val2)};
-                      });
-    return v;
+    return detail::zip_view{views::all(std::forward<decltype(rng1)>(rng1)),
+                            views::all(std::forward<decltype(rng2)>(rng2))};
+  };
+
+  inline constexpr auto zip_with = [](auto f, auto &&rng1, auto &&rng2) {
+    return views::transform(zip(std::forward<decltype(rng1)>(rng1),
+                                std::forward<decltype(rng2)>(rng2)),
+                            [f = std::move(f)](auto &&pair) -> decltype(auto) {
+                              return std::invoke(f, pair.first, pair.second);
+                            });
   };
 
 #ifdef USE_STL2
@@ -78,9 +444,36 @@ NANO_BEGIN_NAMESPACE
 
   } // namespace views
 
+  // common references of zip_pair and std::pair, for the iterator concepts
+  template <typename T1, typename T2, typename U1, typename U2,
+            template <typename> class TQual, template <typename> class UQual>
+  struct basic_common_reference<views::detail::zip_pair<T1, T2>,
+                                std::pair<U1, U2>, TQual, UQual> {
+    using type =
+      views::detail::zip_pair<common_reference_t<TQual<T1>, UQual<U1>>,
+                              common_reference_t<TQual<T2>, UQual<U2>>>;
+  };
+
+  template <typename T1, typename T2, typename U1, typename U2,
+            template <typename> class TQual, template <typename> class UQual>
+  struct basic_common_reference<std::pair<T1, T2>,
+                                views::detail::zip_pair<U1, U2>, TQual, UQual>
+    : basic_common_reference<views::detail::zip_pair<U1, U2>,
+                             std::pair<T1, T2>, UQual, TQual> {};
+
+  template <typename T1, typename T2, typename U1, typename U2,
+            template <typename> class TQual, template <typename> class UQual>
+  struct basic_common_reference<views::detail::zip_pair<T1, T2>,
+                                views::detail::zip_pair<U1, U2>, TQual, UQual>
+    : basic_common_reference<views::detail::zip_pair<T1, T2>,
+                             std::pair<U1, U2>, TQual, UQual> {};
+#endif
+
 #ifdef USE_STL2
 }
 STL2_CLOSE_NAMESPACE
+#elif defined(USE_STD_RANGES)
+} // namespace ranges
 #else
 NANO_END_NAMESPACE
 #endif // USE_STL2
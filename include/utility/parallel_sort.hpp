@@ -0,0 +1,294 @@
+#pragma once
+#include "utility/execution.hpp"
+#include "utility/functional.hpp"
+#include "utility/pdq_sort.hpp"
+#include "utility/reduce.hpp"
+#include "utility/sort.hpp"
+#include "utility/thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utility {
+
+namespace detail::parallel_sort {
+
+// smaller ranges are sorted on the calling thread
+constexpr std::ptrdiff_t sequential_threshold = 1 << 15;
+// splitters are picked among this many samples per bucket
+constexpr std::ptrdiff_t oversampling = 16;
+
+// samplesort: splitters picked from a regular sample cut the range into
+// buckets, which are sorted independently. every chunk of the range counts
+// then moves its elements to their bucket in a buffer, in parallel. elements
+// equivalent to a splitter get a bucket of their own, which needs no sorting,
+// so that duplicated keys cannot produce an oversized bucket.
+template <typename I, typename Comp, typename Proj>
+void samplesort(thread_pool &pool, I first, I last, Comp &comp, Proj &proj) {
+  using value_type = std::iter_value_t<I>;
+  using key_type   = std::remove_cv_t<
+    std::remove_reference_t<std::invoke_result_t<Proj &, decltype(*first)>>>;
+  const auto size   = last - first;
+  const auto chunks = detail::chunk_count(size);
+
+  std::vector<key_type> splitters;
+  splitters.reserve(static_cast<std::size_t>(chunks * oversampling));
+  for (std::ptrdiff_t sample = 0; sample != chunks * oversampling; ++sample) {
+    splitters.push_back(
+      std::invoke(proj, first[sample * size / (chunks * oversampling)]));
+  }
+  std::sort(splitters.begin(), splitters.end(), std::ref(comp));
+  for (std::ptrdiff_t bucket = 1; bucket != chunks; ++bucket) {
+    splitters[static_cast<std::size_t>(bucket - 1)] =
+      std::move(splitters[static_cast<std::size_t>(bucket * oversampling)]);
+  }
+  splitters.resize(static_cast<std::size_t>(chunks - 1));
+  splitters.erase(std::unique(splitters.begin(), splitters.end(),
+                              [&](const auto &lhs, const auto &rhs) {
+                                return !std::invoke(comp, lhs, rhs);
+                              }),
+                  splitters.end());
+
+  // bucket 2 * i holds the elements between splitters i - 1 and i, bucket
+  // 2 * i + 1 those equivalent to splitter i
+  const auto buckets = 2 * splitters.size() + 1;
+  std::vector<uint16_t> bucket_of(static_cast<std::size_t>(size));
+  std::vector<std::ptrdiff_t> offsets(static_cast<std::size_t>(chunks)
+                                      * buckets);
+  auto chunk_begin = [&](std::ptrdiff_t chunk) {
+    return chunk * size / chunks;
+  };
+
+  task_group group{pool};
+  for (std::ptrdiff_t chunk = 0; chunk != chunks; ++chunk) {
+    group.run([&, chunk] {
+      auto *counts = &offsets[static_cast<std::size_t>(chunk) * buckets];
+      for (auto index = chunk_begin(chunk); index != chunk_begin(chunk + 1);
+           ++index) {
+        auto &&key  = std::invoke(proj, first[index]);
+        const auto upper =
+          std::upper_bound(splitters.begin(), splitters.end(), key,
+                           std::ref(comp));
+        auto bucket = 2 * static_cast<std::size_t>(upper - splitters.begin());
+        if (upper != splitters.begin()
+            && !std::invoke(comp, *std::prev(upper), key)) {
+          --bucket;
+        }
+        bucket_of[static_cast<std::size_t>(index)] =
+          static_cast<uint16_t>(bucket);
+        ++counts[bucket];
+      }
+    });
+  }
+  group.wait();
+
+  // turns the counts into the offsets of every chunk in every bucket, and
+  // keeps the bounds of the buckets
+  std::vector<std::ptrdiff_t> bounds(buckets + 1);
+  std::ptrdiff_t offset = 0;
+  for (std::size_t bucket = 0; bucket != buckets; ++bucket) {
+    bounds[bucket] = offset;
+    for (std::ptrdiff_t chunk = 0; chunk != chunks; ++chunk) {
+      auto &count = offsets[static_cast<std::size_t>(chunk) * buckets + bucket];
+      offset += std::exchange(count, offset);
+    }
+  }
+  bounds[buckets] = offset;
+
+  std::unique_ptr<value_type[]> buffer{new value_type[size]};
+  for (std::ptrdiff_t chunk = 0; chunk != chunks; ++chunk) {
+    group.run([&, chunk] {
+      auto *chunk_offsets = &offsets[static_cast<std::size_t>(chunk) * buckets];
+      for (auto index = chunk_begin(chunk); index != chunk_begin(chunk + 1);
+           ++index) {
+        auto &slot = chunk_offsets[bucket_of[static_cast<std::size_t>(index)]];
+        buffer[static_cast<std::size_t>(slot++)] = std::move(first[index]);
+      }
+    });
+  }
+  group.wait();
+
+  detail::projected_compare<Comp &, Proj &> compare{comp, proj};
+  for (std::size_t bucket = 0; bucket != buckets; ++bucket) {
+    group.run([&, bucket] {
+      auto *begin = buffer.get() + bounds[bucket];
+      auto *end   = buffer.get() + bounds[bucket + 1];
+      if (bucket % 2 == 0 && end - begin > 1) {
+        detail::pdq::sort_loop<detail::pdq::branchless_compare<Comp, key_type>>(
+          begin, end, compare, detail::pdq::log2(end - begin));
+      }
+      std::move(begin, end, first + bounds[bucket]);
+    });
+  }
+  group.wait();
+}
+
+// the number of elements of `a` among the first `k` elements of the stable
+// merge of `a` and `b`
+template <typename I, typename Comp>
+std::ptrdiff_t co_rank(std::ptrdiff_t k, I a, std::ptrdiff_t a_size, I b,
+                       std::ptrdiff_t b_size, Comp &comp) {
+  auto low  = std::max<std::ptrdiff_t>(0, k - b_size);
+  auto high = std::min(k, a_size);
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    if (comp(b[k - middle - 1], a[middle])) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
+// merges the sorted ranges [a, a_last) and [b, b_last) into `out`, stable.
+// elements are compared before they are moved, as lvalues, which projections
+// taking a non-const reference require.
+template <typename I, typename O, typename Comp>
+void move_merge(I a, I a_last, I b, I b_last, O out, Comp &comp) {
+  for (; a != a_last && b != b_last; ++out) {
+    if (comp(*b, *a)) {
+      *out = std::move(*b);
+      ++b;
+    } else {
+      *out = std::move(*a);
+      ++a;
+    }
+  }
+  std::move(b, b_last, std::move(a, a_last, out));
+}
+
+// stable sorts every chunk, then merges pairs of sorted runs until one is
+// left. each merge is split into pieces of about a chunk, found with
+// co_rank, so that the last merges use every thread too.
+template <typename I, typename Comp>
+void merge_sort(thread_pool &pool, I first, I last, Comp &comp) {
+  using value_type  = std::iter_value_t<I>;
+  const auto size   = last - first;
+  const auto chunks = detail::chunk_count(size);
+  auto chunk_begin  = [&](std::ptrdiff_t chunk) {
+    return chunk * size / chunks;
+  };
+
+  task_group group{pool};
+  for (std::ptrdiff_t chunk = 0; chunk != chunks; ++chunk) {
+    group.run([&, chunk] {
+      std::stable_sort(first + chunk_begin(chunk),
+                       first + chunk_begin(chunk + 1), std::ref(comp));
+    });
+  }
+  group.wait();
+
+  std::unique_ptr<value_type[]> buffer{new value_type[size]};
+  const auto piece_size = size / chunks + 1;
+  // merges the pairs of sorted runs of `run` chunks from `from` to `to`
+  auto merge_runs = [&](auto from, auto to, std::ptrdiff_t run) {
+    for (std::ptrdiff_t chunk = 0; chunk < chunks; chunk += 2 * run) {
+      const auto begin  = chunk_begin(chunk);
+      const auto middle = chunk_begin(std::min(chunk + run, chunks));
+      const auto end    = chunk_begin(std::min(chunk + 2 * run, chunks));
+      for (auto piece = begin; piece < end; piece += piece_size) {
+        group.run([&, begin, middle, end, piece] {
+          const auto piece_end = std::min(piece + piece_size, end);
+          const auto a         = from + begin;
+          const auto b         = from + middle;
+          const auto a_size    = middle - begin;
+          const auto b_size    = end - middle;
+          const auto a_first =
+            co_rank(piece - begin, a, a_size, b, b_size, comp);
+          const auto a_last =
+            co_rank(piece_end - begin, a, a_size, b, b_size, comp);
+          move_merge(a + a_first, a + a_last, b + (piece - begin - a_first),
+                     b + (piece_end - begin - a_last), to + piece, comp);
+        });
+      }
+    }
+    group.wait();
+  };
+
+  bool in_buffer = false;
+  for (std::ptrdiff_t run = 1; run < chunks; run *= 2) {
+    if (in_buffer) {
+      merge_runs(buffer.get(), first, run);
+    } else {
+      merge_runs(first, buffer.get(), run);
+    }
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer) {
+    for (std::ptrdiff_t chunk = 0; chunk != chunks; ++chunk) {
+      group.run([&, chunk] {
+        std::move(buffer.get() + chunk_begin(chunk),
+                  buffer.get() + chunk_begin(chunk + 1),
+                  first + chunk_begin(chunk));
+      });
+    }
+    group.wait();
+  }
+}
+
+} // namespace detail::parallel_sort
+
+template <typename Rng, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void sort(execution::sequenced_policy, Rng &&rng, Comp comp = {},
+          Proj proj = {}) {
+  utility::sort(std::forward<Rng>(rng), std::move(comp), std::move(proj));
+}
+
+// sorts a random access range with a samplesort on the policy thread pool,
+// or with pdq_sort below a few tens of thousands of elements and on a pool
+// without workers. not stable. elements must be default constructible.
+template <typename Rng, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void sort(execution::parallel_policy policy, Rng &&rng, Comp comp = {},
+          Proj proj = {}) {
+  const auto first = std::begin(rng);
+  const auto last  = std::end(rng);
+  auto &pool       = policy.pool();
+  if (last - first < detail::parallel_sort::sequential_threshold
+      || pool.size() == 0) {
+    utility::pdq_sort(rng, std::move(comp), std::move(proj));
+    return;
+  }
+  detail::parallel_sort::samplesort(pool, first, last, comp, proj);
+}
+
+template <typename Rng, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void stable_sort(execution::sequenced_policy, Rng &&rng, Comp comp = {},
+                 Proj proj = {}) {
+  detail::projected_compare<Comp, Proj> compare{std::move(comp),
+                                                std::move(proj)};
+  std::stable_sort(std::begin(rng), std::end(rng), compare);
+}
+
+// stable sorts a random access range by merging sorted chunks on the policy
+// thread pool, or with std::stable_sort below a few tens of thousands of
+// elements and on a pool without workers. elements must be default
+// constructible.
+template <typename Rng, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void stable_sort(execution::parallel_policy policy, Rng &&rng,
+                 Comp comp = {}, Proj proj = {}) {
+  const auto first = std::begin(rng);
+  const auto last  = std::end(rng);
+  auto &pool       = policy.pool();
+  if (last - first < detail::parallel_sort::sequential_threshold
+      || pool.size() == 0) {
+    utility::stable_sort(execution::seq, rng, std::move(comp),
+                         std::move(proj));
+    return;
+  }
+  detail::projected_compare<Comp, Proj> compare{std::move(comp),
+                                                std::move(proj)};
+  detail::parallel_sort::merge_sort(pool, first, last, compare);
+}
+
+} // namespace utility
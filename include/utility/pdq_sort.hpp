@@ -0,0 +1,413 @@
+#pragma once
+#include "utility/functional.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace utility {
+
+namespace detail::pdq {
+
+// partitions below this size are insertion sorted
+constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+// partitions above this size use the pseudomedian of 9 as pivot
+constexpr std::ptrdiff_t ninther_threshold = 128;
+// partial_insertion_sort gives up after moving this many elements
+constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
+// elements classified at once by the branchless partition
+constexpr std::ptrdiff_t block_size = 64;
+constexpr std::size_t cacheline_size = 64;
+
+// elements are moved and swapped through their iterators, which handles proxy
+// references such as those of vector<bool> or of zip views
+using std::ranges::iter_move;
+using std::ranges::iter_swap;
+
+template <typename I, typename Comp>
+void insertion_sort(I begin, I end, Comp &comp) {
+  if (begin == end) {
+    return;
+  }
+  for (auto cur = begin + 1; cur != end; ++cur) {
+    auto sift   = cur;
+    auto sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      std::iter_value_t<I> tmp = iter_move(sift);
+      do {
+        *sift-- = iter_move(sift_1);
+      } while (sift != begin && comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+// same as insertion_sort, but *(begin - 1) must not be greater than any
+// element of [begin, end), which stops the inner loop without a bound check
+template <typename I, typename Comp>
+void unguarded_insertion_sort(I begin, I end, Comp &comp) {
+  if (begin == end) {
+    return;
+  }
+  for (auto cur = begin + 1; cur != end; ++cur) {
+    auto sift   = cur;
+    auto sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      std::iter_value_t<I> tmp = iter_move(sift);
+      do {
+        *sift-- = iter_move(sift_1);
+      } while (comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+    }
+  }
+}
+
+// insertion sorts while few elements need moving, returns whether the range
+// got sorted
+template <typename I, typename Comp>
+bool partial_insertion_sort(I begin, I end, Comp &comp) {
+  if (begin == end) {
+    return true;
+  }
+  std::ptrdiff_t moved = 0;
+  for (auto cur = begin + 1; cur != end; ++cur) {
+    auto sift   = cur;
+    auto sift_1 = cur - 1;
+    if (comp(*sift, *sift_1)) {
+      std::iter_value_t<I> tmp = iter_move(sift);
+      do {
+        *sift-- = iter_move(sift_1);
+      } while (sift != begin && comp(tmp, *--sift_1));
+      *sift = std::move(tmp);
+      moved += cur - sift;
+    }
+    if (moved > partial_insertion_sort_limit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename I, typename Comp> void sort2(I a, I b, Comp &comp) {
+  if (comp(*b, *a)) {
+    iter_swap(a, b);
+  }
+}
+
+template <typename I, typename Comp> void sort3(I a, I b, I c, Comp &comp) {
+  sort2(a, b, comp);
+  sort2(b, c, comp);
+  sort2(a, b, comp);
+}
+
+// swaps first[offsets_l[i]] with last[-offsets_r[i]], as a cycle of moves
+// unless both sides have the same number of misplaced elements
+template <typename I>
+void swap_offsets(I first, I last, const unsigned char *offsets_l,
+                  const unsigned char *offsets_r, std::ptrdiff_t count,
+                  bool use_swaps) {
+  if (use_swaps) {
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      iter_swap(first + offsets_l[i], last - offsets_r[i]);
+    }
+  } else if (count > 0) {
+    auto l                   = first + offsets_l[0];
+    auto r                   = last - offsets_r[0];
+    std::iter_value_t<I> tmp = iter_move(l);
+    *l                       = iter_move(r);
+    for (std::ptrdiff_t i = 1; i < count; ++i) {
+      l  = first + offsets_l[i];
+      *r = iter_move(l);
+      r  = last - offsets_r[i];
+      *l = iter_move(r);
+    }
+    *r = std::move(tmp);
+  }
+}
+
+// partitions [begin, end) around *begin into elements less than the pivot
+// and the others. returns the position of the pivot and whether the range was
+// already partitioned. elements are classified a block at a time into
+// offsets, without branching on the comparison, then swapped.
+template <typename I, typename Comp>
+std::pair<I, bool> partition_right_branchless(I begin, I end, Comp &comp) {
+  std::iter_value_t<I> pivot = iter_move(begin);
+  auto first                 = begin;
+  auto last                  = end;
+
+  // the median of 3 guarantees an element not less than the pivot at the
+  // end, and one not greater at the beginning
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  const bool already_partitioned = first >= last;
+  if (!already_partitioned) {
+    iter_swap(first, last);
+    ++first;
+
+    alignas(cacheline_size) unsigned char offsets_l[block_size];
+    alignas(cacheline_size) unsigned char offsets_r[block_size];
+    auto offsets_l_base    = first;
+    auto offsets_r_base    = last;
+    std::ptrdiff_t num_l   = 0;
+    std::ptrdiff_t num_r   = 0;
+    std::ptrdiff_t start_l = 0;
+    std::ptrdiff_t start_r = 0;
+
+    while (first < last) {
+      // fill the offset blocks which are empty, splitting the unknown
+      // elements between them when both are
+      const auto unknown = last - first;
+      const auto left_split =
+        num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+      const auto right_split = num_r == 0 ? unknown - left_split : 0;
+
+      for (std::ptrdiff_t i = 0; i < std::min(left_split, block_size); ++i) {
+        offsets_l[num_l] = static_cast<unsigned char>(i);
+        num_l += !comp(*first, pivot);
+        ++first;
+      }
+      for (std::ptrdiff_t i = 0; i < std::min(right_split, block_size);) {
+        offsets_r[num_r] = static_cast<unsigned char>(++i);
+        num_r += comp(*--last, pivot);
+      }
+
+      const auto count = std::min(num_l, num_r);
+      swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                   offsets_r + start_r, count, num_l == num_r);
+      num_l -= count;
+      num_r -= count;
+      start_l += count;
+      start_r += count;
+      if (num_l == 0) {
+        start_l        = 0;
+        offsets_l_base = first;
+      }
+      if (num_r == 0) {
+        start_r        = 0;
+        offsets_r_base = last;
+      }
+    }
+
+    // one of the blocks may still hold misplaced elements, move them next to
+    // the middle
+    if (num_l != 0) {
+      while (num_l--) {
+        iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+      }
+      first = last;
+    }
+    if (num_r != 0) {
+      while (num_r--) {
+        iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+        ++first;
+      }
+      last = first;
+    }
+  }
+
+  const auto pivot_pos = first - 1;
+  *begin               = iter_move(pivot_pos);
+  *pivot_pos           = std::move(pivot);
+  return {pivot_pos, already_partitioned};
+}
+
+// same as partition_right_branchless, branching on every comparison. faster
+// when comparisons are expensive or their outcome is predictable.
+template <typename I, typename Comp>
+std::pair<I, bool> partition_right(I begin, I end, Comp &comp) {
+  std::iter_value_t<I> pivot = iter_move(begin);
+  auto first                 = begin;
+  auto last                  = end;
+
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  const bool already_partitioned = first >= last;
+  while (first < last) {
+    iter_swap(first, last);
+    while (comp(*++first, pivot)) {
+    }
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  const auto pivot_pos = first - 1;
+  *begin               = iter_move(pivot_pos);
+  *pivot_pos           = std::move(pivot);
+  return {pivot_pos, already_partitioned};
+}
+
+// partitions into elements equal to the pivot and greater ones, used when the
+// pivot equals the one of the parent partition, i.e. on many duplicates
+template <typename I, typename Comp>
+I partition_left(I begin, I end, Comp &comp) {
+  std::iter_value_t<I> pivot = iter_move(begin);
+  auto first                 = begin;
+  auto last                  = end;
+
+  while (comp(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first)) {
+    }
+  } else {
+    while (!comp(pivot, *++first)) {
+    }
+  }
+
+  while (first < last) {
+    iter_swap(first, last);
+    while (comp(pivot, *--last)) {
+    }
+    while (!comp(pivot, *++first)) {
+    }
+  }
+
+  const auto pivot_pos = last;
+  *begin               = iter_move(pivot_pos);
+  *pivot_pos           = std::move(pivot);
+  return pivot_pos;
+}
+
+template <bool Branchless, typename I, typename Comp>
+void sort_loop(I begin, I end, Comp &comp, int bad_allowed,
+               bool leftmost = true) {
+  while (true) {
+    const auto size = end - begin;
+    if (size < insertion_sort_threshold) {
+      if (leftmost) {
+        insertion_sort(begin, end, comp);
+      } else {
+        unguarded_insertion_sort(begin, end, comp);
+      }
+      return;
+    }
+
+    // the pivot goes to *begin
+    const auto half = size / 2;
+    if (size > ninther_threshold) {
+      sort3(begin, begin + half, end - 1, comp);
+      sort3(begin + 1, begin + (half - 1), end - 2, comp);
+      sort3(begin + 2, begin + (half + 1), end - 3, comp);
+      sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+      iter_swap(begin, begin + half);
+    } else {
+      sort3(begin + half, begin, end - 1, comp);
+    }
+
+    // the element before a partition which is not the leftmost one is its
+    // parent pivot. if it equals the new pivot, all the elements equal to it
+    // go left and are done.
+    if (!leftmost && !comp(*(begin - 1), *begin)) {
+      begin = partition_left(begin, end, comp) + 1;
+      continue;
+    }
+
+    const auto [pivot_pos, already_partitioned] =
+      Branchless ? partition_right_branchless(begin, end, comp)
+                 : partition_right(begin, end, comp);
+
+    const auto l_size = pivot_pos - begin;
+    const auto r_size = end - (pivot_pos + 1);
+    if (l_size < size / 8 || r_size < size / 8) {
+      // too many bad partitions, fall back to a guaranteed O(n log n)
+      if (--bad_allowed == 0) {
+        std::make_heap(begin, end, comp);
+        std::sort_heap(begin, end, comp);
+        return;
+      }
+
+      // break patterns which could lead to bad pivots
+      if (l_size >= insertion_sort_threshold) {
+        iter_swap(begin, begin + l_size / 4);
+        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > ninther_threshold) {
+          iter_swap(begin + 1, begin + (l_size / 4 + 1));
+          iter_swap(begin + 2, begin + (l_size / 4 + 2));
+          iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+          iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+      }
+      if (r_size >= insertion_sort_threshold) {
+        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        iter_swap(end - 1, end - r_size / 4);
+        if (r_size > ninther_threshold) {
+          iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+          iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+          iter_swap(end - 2, end - (1 + r_size / 4));
+          iter_swap(end - 3, end - (2 + r_size / 4));
+        }
+      }
+    } else if (already_partitioned
+               && partial_insertion_sort(begin, pivot_pos, comp)
+               && partial_insertion_sort(pivot_pos + 1, end, comp)) {
+      // a balanced partition which needed no swap, likely sorted input
+      return;
+    }
+
+    // recurse into the left partition, loop on the right one
+    sort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+    begin    = pivot_pos + 1;
+    leftmost = false;
+  }
+}
+
+// comparisons of arithmetic keys by std::less or std::greater are cheap and
+// unpredictable, they are not branched on
+template <typename Comp, typename Key>
+constexpr bool branchless_compare =
+  std::is_arithmetic_v<Key>
+  && (std::is_same_v<Comp, std::less<>> || std::is_same_v<Comp, std::less<Key>>
+      || std::is_same_v<Comp, std::greater<>>
+      || std::is_same_v<Comp, std::greater<Key>>);
+
+inline int log2(std::ptrdiff_t n) {
+  int log = 0;
+  while (n >>= 1) {
+    ++log;
+  }
+  return log;
+}
+
+} // namespace detail::pdq
+
+// sorts a random access range with pattern-defeating quicksort: introsort
+// whose pivots are medians of 3 or 9, with insertion sort for small
+// partitions, block partitioning which does not branch on comparisons of
+// arithmetic keys, linear time on sorted and reversed inputs, and heap sort
+// once partitions are too unbalanced. not stable.
+template <typename Rng, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void pdq_sort(Rng &&rng, Comp comp = {}, Proj proj = {}) {
+  const auto first = std::begin(rng);
+  const auto last  = std::end(rng);
+  if (first == last) {
+    return;
+  }
+  using key_type = std::remove_cv_t<std::remove_reference_t<
+    std::invoke_result_t<Proj &, decltype(*first)>>>;
+  detail::projected_compare<Comp, Proj> compare{std::move(comp),
+                                                std::move(proj)};
+  detail::pdq::sort_loop<detail::pdq::branchless_compare<Comp, key_type>>(
+    first, last, compare, detail::pdq::log2(last - first));
+}
+
+} // namespace utility
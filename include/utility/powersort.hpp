@@ -0,0 +1,228 @@
+#pragma once
+#include "utility/functional.hpp"
+#include "utility/pdq_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utility {
+
+namespace detail::powersort {
+
+// shorter runs are extended with insertion sort
+constexpr std::ptrdiff_t min_run = 24;
+// merges switch to galloping after this many elements in a row from one run
+constexpr std::ptrdiff_t min_gallop = 7;
+
+struct run {
+  std::ptrdiff_t begin;
+  std::ptrdiff_t end;
+  unsigned power;
+};
+
+// the end of the run starting at `first`. strictly descending runs are
+// reversed, which keeps equal elements in order.
+template <typename I, typename Comp> I find_run(I first, I last, Comp &comp) {
+  auto it = std::next(first);
+  if (it == last) {
+    return it;
+  }
+  if (comp(*it, *first)) {
+    while (++it != last && comp(*it, *std::prev(it))) {
+    }
+    std::reverse(first, it);
+  } else {
+    while (++it != last && !comp(*it, *std::prev(it))) {
+    }
+  }
+  return it;
+}
+
+// the depth of the node between two adjacent runs in the tree of merges
+// which splits [0, size) evenly: the first bit where the binary expansions
+// of the relative midpoints of both runs differ
+inline unsigned node_power(std::ptrdiff_t size, std::ptrdiff_t begin_a,
+                           std::ptrdiff_t begin_b, std::ptrdiff_t end_b) {
+  // twice the midpoints, over 2 * size
+  auto a = static_cast<std::size_t>(begin_a + begin_b);
+  auto b = static_cast<std::size_t>(begin_b + end_b);
+  const auto n = static_cast<std::size_t>(size);
+  unsigned power = 1;
+  for (;; ++power) {
+    const bool bit_a = a >= n;
+    const bool bit_b = b >= n;
+    if (bit_a != bit_b) {
+      return power;
+    }
+    if (bit_a) {
+      a -= n;
+      b -= n;
+    }
+    a *= 2;
+    b *= 2;
+  }
+}
+
+// the first element of [first, last) which is not less than `value`, found
+// by looking at 1, 2, 4... elements ahead first
+template <typename I, typename T, typename Comp>
+I gallop_lower_bound(I first, I last, const T &value, Comp &comp) {
+  std::ptrdiff_t step = 1;
+  auto low            = first;
+  while (last - low > step && comp(low[step], value)) {
+    low += step;
+    step *= 2;
+  }
+  return std::lower_bound(low, low + std::min(step + 1, last - low), value,
+                          std::ref(comp));
+}
+
+// the first element of [first, last) which is greater than `value`
+template <typename I, typename T, typename Comp>
+I gallop_upper_bound(I first, I last, const T &value, Comp &comp) {
+  std::ptrdiff_t step = 1;
+  auto low            = first;
+  while (last - low > step && !comp(value, low[step])) {
+    low += step;
+    step *= 2;
+  }
+  return std::upper_bound(low, low + std::min(step + 1, last - low), value,
+                          std::ref(comp));
+}
+
+// merges the sorted runs [first, middle) and [middle, last), moving the
+// first one to `buffer`. once a run wins min_gallop times in a row, the
+// number of elements it wins next is searched for instead of compared one
+// by one.
+template <typename I, typename B, typename Comp>
+void merge_low(I first, I middle, I last, B buffer, Comp &comp) {
+  const auto buffer_end = std::move(first, middle, buffer);
+  auto out              = first;
+  auto right            = middle;
+  std::ptrdiff_t left_wins  = 0;
+  std::ptrdiff_t right_wins = 0;
+  while (buffer != buffer_end && right != last) {
+    if (comp(*right, *buffer)) {
+      left_wins = 0;
+      if (++right_wins >= min_gallop) {
+        const auto stop = gallop_lower_bound(right, last, *buffer, comp);
+        out             = std::move(right, stop, out);
+        right           = stop;
+        right_wins      = 0;
+      } else {
+        *out++ = std::move(*right++);
+      }
+    } else {
+      right_wins = 0;
+      if (++left_wins >= min_gallop) {
+        const auto stop = gallop_upper_bound(buffer, buffer_end, *right, comp);
+        out             = std::move(buffer, stop, out);
+        buffer          = stop;
+        left_wins       = 0;
+      } else {
+        *out++ = std::move(*buffer++);
+      }
+    }
+  }
+  std::move(buffer, buffer_end, out);
+}
+
+// merges [first, middle) and [middle, last) with a buffer as large as the
+// shortest of the two, after skipping the elements already in place
+template <typename I, typename T, typename Alloc, typename Comp>
+void merge(I first, I middle, I last, std::vector<T, Alloc> &scratch,
+           Comp &comp) {
+  first = std::upper_bound(first, middle, *middle, std::ref(comp));
+  last  = std::lower_bound(middle, last, *std::prev(middle), std::ref(comp));
+  if (first == middle || middle == last) {
+    return;
+  }
+  const auto shortest =
+    static_cast<std::size_t>(std::min(middle - first, last - middle));
+  if (scratch.size() < shortest) {
+    scratch.resize(shortest);
+  }
+  if (middle - first <= last - middle) {
+    merge_low(first, middle, last, scratch.begin(), comp);
+  } else {
+    // merging backwards, from the largest elements, is merging forwards the
+    // reversed runs with the arguments of the comparison swapped, which
+    // still favours the left run on ties
+    auto swapped = [&](auto &&lhs, auto &&rhs) { return comp(rhs, lhs); };
+    merge_low(std::make_reverse_iterator(last),
+              std::make_reverse_iterator(middle),
+              std::make_reverse_iterator(first), scratch.begin(), swapped);
+  }
+}
+
+} // namespace detail::powersort
+
+// stable sorts a random access range by merging the runs already present in
+// it, in the order given by powersort, which is close to optimal for the
+// lengths of the runs. sorted and reverse sorted ranges take linear time.
+// merges use `scratch`, grown to at most half of the size of the range,
+// which can be reused across calls. elements must be default constructible.
+template <typename Rng, typename T, typename Alloc, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void powersort(Rng &&rng, std::vector<T, Alloc> &scratch, Comp comp = {},
+               Proj proj = {}) {
+  namespace ps     = detail::powersort;
+  const auto first = std::begin(rng);
+  const auto last  = std::end(rng);
+  static_assert(std::is_same_v<T, std::iter_value_t<decltype(first)>>,
+                "the scratch buffer must hold the elements of the range");
+  const auto size = last - first;
+  if (size < 2) {
+    return;
+  }
+  detail::projected_compare<Comp, Proj> compare{std::move(comp),
+                                                std::move(proj)};
+
+  auto next_run = [&](std::ptrdiff_t begin) {
+    auto end = ps::find_run(first + begin, last, compare) - first;
+    if (end - begin < ps::min_run && end != size) {
+      end = std::min(begin + ps::min_run, size);
+      detail::pdq::insertion_sort(first + begin, first + end, compare);
+    }
+    return end;
+  };
+
+  // the powers of the runs on the stack increase from bottom to top
+  std::array<ps::run, std::numeric_limits<std::size_t>::digits + 1> stack;
+  std::size_t height = 0;
+  ps::run current{0, next_run(0), 0};
+  while (current.end != size) {
+    const ps::run next{current.end, next_run(current.end), 0};
+    const auto power =
+      ps::node_power(size, current.begin, next.begin, next.end);
+    while (height != 0 && stack[height - 1].power > power) {
+      const auto &top = stack[--height];
+      ps::merge(first + top.begin, first + top.end, first + current.end,
+                scratch, compare);
+      current.begin = top.begin;
+    }
+    stack[height++] = {current.begin, current.end, power};
+    current         = next;
+  }
+  while (height != 0) {
+    const auto &top = stack[--height];
+    ps::merge(first + top.begin, first + top.end, first + current.end,
+              scratch, compare);
+    current.begin = top.begin;
+  }
+}
+
+template <typename Rng, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void powersort(Rng &&rng, Comp comp = {}, Proj proj = {}) {
+  std::vector<std::iter_value_t<decltype(std::begin(rng))>> scratch;
+  utility::powersort(rng, scratch, std::move(comp), std::move(proj));
+}
+
+} // namespace utility
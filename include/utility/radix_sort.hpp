@@ -0,0 +1,242 @@
+#pragma once
+#include "utility/functional.hpp"
+#include "utility/pdq_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace utility {
+
+namespace detail::radix {
+
+// keys are distributed one byte at a time
+constexpr std::size_t radix = 1 << CHAR_BIT;
+// string buckets up to this size are finished with a comparison sort
+constexpr std::ptrdiff_t small_bucket_size = 64;
+
+// maps keys to unsigned integers of the same width, preserving their order
+template <typename Key, typename = void> struct key_traits;
+
+template <typename Key>
+struct key_traits<Key, std::enable_if_t<std::is_integral_v<Key>
+                                        && !std::is_same_v<Key, bool>>> {
+  using type = std::make_unsigned_t<Key>;
+
+  static constexpr type encode(Key key) noexcept {
+    auto bits = static_cast<type>(key);
+    if constexpr (std::is_signed_v<Key>) {
+      // negative numbers first
+      bits ^= type{1} << (std::numeric_limits<type>::digits - 1);
+    }
+    return bits;
+  }
+};
+
+template <typename Key>
+struct key_traits<Key, std::enable_if_t<std::is_floating_point_v<Key>
+                                        && std::numeric_limits<Key>::is_iec559
+                                        && (sizeof(Key) == sizeof(uint32_t)
+                                            || sizeof(Key)
+                                                 == sizeof(uint64_t))>> {
+  using type = std::conditional_t<sizeof(Key) == sizeof(uint32_t), uint32_t,
+                                  uint64_t>;
+
+  static type encode(Key key) noexcept {
+    type bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    constexpr auto sign_shift = std::numeric_limits<type>::digits - 1;
+    // sets the sign bit of positive numbers, and flips every bit of negative
+    // ones, whose magnitudes are ordered backwards
+    const auto mask = static_cast<type>(-(bits >> sign_shift))
+                      | (type{1} << sign_shift);
+    return bits ^ mask;
+  }
+};
+
+template <typename Key, typename = void>
+constexpr bool is_fixed_width_key = false;
+
+template <typename Key>
+constexpr bool
+  is_fixed_width_key<Key, std::void_t<typename key_traits<Key>::type>> = true;
+
+template <typename Key>
+constexpr bool is_string_key = std::is_convertible_v<const Key &,
+                                                     std::string_view>;
+
+// moves every element of [first, last) to out[offsets[digit]++]
+template <typename In, typename Out, typename Bits>
+void scatter(In first, In last, Out out,
+             std::array<std::ptrdiff_t, radix> &offsets, unsigned shift,
+             Bits &bits) {
+  for (; first != last; ++first) {
+    auto &offset = offsets[(bits(*first) >> shift) & (radix - 1)];
+    out[offset++] = std::move(*first);
+  }
+}
+
+template <typename Key, typename I, typename Proj>
+void lsd_sort(I first, I last, Proj &proj) {
+  using traits     = key_traits<Key>;
+  using bits_type  = typename traits::type;
+  using value_type = std::iter_value_t<I>;
+  constexpr std::size_t passes = sizeof(bits_type);
+
+  auto bits = [&](auto &&value) {
+    return traits::encode(std::invoke(proj, value));
+  };
+  const auto size = last - first;
+  if (size <= pdq::insertion_sort_threshold) {
+    auto less = [&](auto &&lhs, auto &&rhs) { return bits(lhs) < bits(rhs); };
+    pdq::insertion_sort(first, last, less);
+    return;
+  }
+
+  // the histograms of every byte, counted in a single pass
+  std::array<std::array<std::size_t, radix>, passes> counts{};
+  for (auto it = first; it != last; ++it) {
+    const auto key = bits(*it);
+    for (std::size_t pass = 0; pass != passes; ++pass) {
+      ++counts[pass][(key >> (pass * CHAR_BIT)) & (radix - 1)];
+    }
+  }
+
+  const auto first_key = bits(*first);
+  std::unique_ptr<value_type[]> buffer{new value_type[size]};
+  bool in_buffer = false;
+  for (std::size_t pass = 0; pass != passes; ++pass) {
+    const auto shift = static_cast<unsigned>(pass * CHAR_BIT);
+    const auto &count = counts[pass];
+    // every key has the same byte, the pass would not move anything
+    if (count[(first_key >> shift) & (radix - 1)]
+        == static_cast<std::size_t>(size)) {
+      continue;
+    }
+    std::array<std::ptrdiff_t, radix> offsets;
+    std::ptrdiff_t offset = 0;
+    for (std::size_t digit = 0; digit != radix; ++digit) {
+      offsets[digit] = offset;
+      offset += static_cast<std::ptrdiff_t>(count[digit]);
+    }
+    if (in_buffer) {
+      scatter(buffer.get(), buffer.get() + size, first, offsets, shift, bits);
+    } else {
+      scatter(first, last, buffer.get(), offsets, shift, bits);
+    }
+    in_buffer = !in_buffer;
+  }
+  if (in_buffer) {
+    std::move(buffer.get(), buffer.get() + size, first);
+  }
+}
+
+template <typename I, typename Proj>
+void msd_sort(I first, I last, Proj &proj, std::size_t depth) {
+  auto key = [&](auto &&value) -> std::string_view {
+    return std::invoke(proj, value);
+  };
+  // 0 for the keys which end before depth, ordering them first
+  auto digit = [&](auto &&value) -> std::size_t {
+    const auto k = key(value);
+    return depth < k.size() ? 1 + static_cast<unsigned char>(k[depth]) : 0;
+  };
+
+  const auto size = last - first;
+  if (size <= small_bucket_size) {
+    // every key shares its first depth characters
+    auto less = [&](auto &&lhs, auto &&rhs) {
+      return key(lhs).substr(depth) < key(rhs).substr(depth);
+    };
+    pdq::sort_loop<false>(first, last, less, pdq::log2(size));
+    return;
+  }
+
+  std::array<std::ptrdiff_t, radix + 1> heads;
+  std::array<std::ptrdiff_t, radix + 1> tails;
+  for (;;) {
+    tails.fill(0);
+    for (auto it = first; it != last; ++it) {
+      ++tails[digit(*it)];
+    }
+    // a common prefix is skipped without moving anything
+    const auto shared = std::find(tails.begin(), tails.end(), size);
+    if (shared == tails.begin()) {
+      return;
+    }
+    if (shared == tails.end()) {
+      break;
+    }
+    ++depth;
+  }
+
+  std::ptrdiff_t offset = 0;
+  for (std::size_t bucket = 0; bucket != radix + 1; ++bucket) {
+    heads[bucket] = offset;
+    offset += tails[bucket];
+    tails[bucket] = offset;
+  }
+  // american flag sort: swaps each element into the next free slot of its
+  // bucket, until every bucket is full
+  for (std::size_t bucket = 0; bucket != radix + 1; ++bucket) {
+    while (heads[bucket] != tails[bucket]) {
+      const auto other = digit(first[heads[bucket]]);
+      if (other == bucket) {
+        ++heads[bucket];
+      } else {
+        std::ranges::iter_swap(first + heads[bucket], first + heads[other]++);
+      }
+    }
+  }
+
+  // the keys of the first bucket are equal
+  for (std::size_t bucket = 1; bucket != radix + 1; ++bucket) {
+    const auto begin = tails[bucket - 1];
+    if (tails[bucket] - begin > 1) {
+      msd_sort(first + begin, first + tails[bucket], proj, depth + 1);
+    }
+  }
+}
+
+} // namespace detail::radix
+
+// sorts a random access range by the projections of its elements, without
+// comparing them:
+// - integral and IEEE floating point keys are sorted by a stable pass per
+//   byte, least significant first, skipping the bytes shared by every key.
+//   elements are moved between the range and a buffer of the same size, so
+//   they must be default constructible. -0.0 is ordered before 0.0
+// - keys convertible to std::string_view are distributed by their
+//   characters in place, most significant first, and buckets of a few
+//   elements are finished by pdq_sort. not stable
+template <typename Rng, typename Proj = detail::identity>
+void radix_sort(Rng &&rng, Proj proj = {}) {
+  const auto first = std::begin(rng);
+  const auto last  = std::end(rng);
+  if (last - first < 2) {
+    return;
+  }
+  using projected_type = std::invoke_result_t<Proj &, decltype(*first)>;
+  using key_type = std::remove_cv_t<std::remove_reference_t<projected_type>>;
+  if constexpr (detail::radix::is_fixed_width_key<key_type>) {
+    detail::radix::lsd_sort<key_type>(first, last, proj);
+  } else {
+    static_assert(detail::radix::is_string_key<key_type>,
+                  "radix_sort needs integral, floating point or string keys");
+    static_assert(std::is_reference_v<projected_type>
+                    || std::is_trivially_copyable_v<key_type>,
+                  "string keys must be projected to references or views");
+    detail::radix::msd_sort(first, last, proj, 0);
+  }
+}
+
+} // namespace utility
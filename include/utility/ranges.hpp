@@ -0,0 +1,35 @@
+#pragma once
+
+// brings in the core of the ranges library a target is built against and
+// makes it available as `ranges`
+#ifdef USE_RANGE_V3
+#include <range/v3/range/concepts.hpp>
+#elif defined(USE_STD_RANGES)
+#include <iterator>
+#include <ranges>
+// std::ranges cannot be extended, `ranges` is a namespace of its own which
+// brings in std::ranges, together with the iterator concepts the other
+// libraries declare next to it, and can hold polyfills. views stays an alias,
+// a namespace of its own would be ambiguous with std::ranges::views after
+// `using namespace ranges`.
+namespace ranges {
+using namespace std::ranges;
+using std::bidirectional_iterator;
+using std::contiguous_iterator;
+using std::forward_iterator;
+using std::input_iterator;
+using std::iter_difference_t;
+using std::iter_reference_t;
+using std::iter_value_t;
+using std::random_access_iterator;
+using std::sentinel_for;
+using std::sized_sentinel_for;
+namespace views = std::ranges::views;
+} // namespace ranges
+#elif defined(USE_NANORANGE)
+#include <nanorange.hpp>
+namespace ranges = nano::ranges;
+#else
+#include <experimental/ranges/ranges>
+namespace ranges = std::experimental::ranges;
+#endif
@@ -0,0 +1,376 @@
+#pragma once
+#include "utility/file_chunks.hpp"
+#include "utility/mapped_file.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef UTILITY_HAS_LIBURING
+#include <cerrno>
+#include <liburing.h>
+#endif
+
+namespace utility {
+
+namespace detail {
+
+// a ring of buffers filled ahead of the consumer. the block returned by next()
+// stays owned by the consumer until the following call to next().
+class prefetcher {
+public:
+  virtual ~prefetcher() = default;
+  virtual byte_span next() = 0;
+};
+
+// runs the reads of every threaded_prefetcher, one after the other, so that
+// opening a file does not start a thread
+class prefetch_thread {
+public:
+  static prefetch_thread &instance() {
+    static prefetch_thread thread;
+    return thread;
+  }
+
+  prefetch_thread(const prefetch_thread &) = delete;
+  prefetch_thread &operator=(const prefetch_thread &) = delete;
+
+  ~prefetch_thread() {
+    {
+      std::lock_guard lock{m_mutex};
+      m_stop = true;
+    }
+    m_wakeup.notify_all();
+    m_thread.join();
+  }
+
+  void submit(std::function<void()> job) {
+    {
+      std::lock_guard lock{m_mutex};
+      m_jobs.push_back(std::move(job));
+    }
+    m_wakeup.notify_one();
+  }
+
+private:
+  prefetch_thread() = default;
+
+  void run() {
+    for (;;) {
+      std::function<void()> job;
+      {
+        std::unique_lock lock{m_mutex};
+        m_wakeup.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty()) {
+          return;
+        }
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+      }
+      job();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::deque<std::function<void()>> m_jobs;
+  bool m_stop = false;
+  std::thread m_thread{[this] { run(); }};
+};
+
+// fills the buffers with blocking reads on the prefetch thread. the reads of
+// a file are queued in the order of its buffers.
+class threaded_prefetcher final : public prefetcher {
+public:
+  threaded_prefetcher(const std::string &path, std::size_t chunk_size,
+                      std::size_t depth) :
+    m_file{path}, m_chunk_size{chunk_size}, m_slots(depth) {
+    std::lock_guard lock{m_mutex};
+    for (std::size_t index = 0; index != m_slots.size(); ++index) {
+      m_slots[index].data = make_aligned_buffer(chunk_size);
+      schedule(index);
+    }
+  }
+
+  ~threaded_prefetcher() override {
+    // queued reads are skipped, but still reference the buffers
+    std::unique_lock lock{m_mutex};
+    m_stop = true;
+    m_changed.wait(lock, [this] { return m_pending == 0; });
+  }
+
+  byte_span next() override {
+    std::unique_lock lock{m_mutex};
+    if (m_current != npos) {
+      m_slots[m_current].full = false;
+      schedule(m_current);
+    }
+    m_current = m_current == npos ? 0 : (m_current + 1) % m_slots.size();
+    auto &slot = m_slots[m_current];
+    m_changed.wait(lock, [&] { return slot.full; });
+    return {slot.data.get(), slot.size};
+  }
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  struct slot_type {
+    aligned_buffer data;
+    std::size_t size = 0;
+    bool full        = false;
+  };
+
+  // with m_mutex held
+  void schedule(std::size_t index) {
+    ++m_pending;
+    prefetch_thread::instance().submit([this, index] { fill(index); });
+  }
+
+  void fill(std::size_t index) {
+    auto &slot = m_slots[index];
+    bool stop  = false;
+    {
+      std::lock_guard lock{m_mutex};
+      stop = m_stop;
+    }
+
+    // fill whole chunks, so that only the last one is short
+    std::size_t size = 0;
+    while (!stop && size != m_chunk_size) {
+      const auto bytes =
+        m_file ? m_file.read(slot.data.get() + size, m_chunk_size - size) : 0;
+      if (bytes == 0) {
+        break;
+      }
+      size += bytes;
+    }
+
+    // notified with the lock held, the destructor may run as soon as it is
+    // released
+    std::lock_guard lock{m_mutex};
+    slot.size = size;
+    slot.full = true;
+    --m_pending;
+    m_changed.notify_all();
+  }
+
+  file_reader m_file;
+  std::size_t m_chunk_size;
+  std::vector<slot_type> m_slots;
+  std::size_t m_current = npos;
+  std::size_t m_pending = 0;
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+  bool m_stop = false;
+};
+
+#ifdef UTILITY_HAS_LIBURING
+// keeps a read in flight for every buffer the consumer does not hold
+class uring_prefetcher final : public prefetcher {
+public:
+  // returns null if the file is not a regular file or the kernel does not
+  // support io_uring
+  static std::unique_ptr<prefetcher>
+  create(const std::string &path, std::size_t chunk_size, std::size_t depth) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return nullptr;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      ::close(fd);
+      return nullptr;
+    }
+    std::unique_ptr<uring_prefetcher> result{new uring_prefetcher{
+      fd, static_cast<std::size_t>(st.st_size), chunk_size, depth}};
+    if (!result->m_initialized) {
+      return nullptr;
+    }
+    return result;
+  }
+
+  ~uring_prefetcher() override {
+    if (m_initialized) {
+      // wait for reads still in flight before their buffers go away
+      for (auto &slot : m_slots) {
+        while (slot.pending) {
+          complete_one();
+        }
+      }
+      io_uring_queue_exit(&m_ring);
+    }
+    ::close(m_fd);
+  }
+
+  byte_span next() override {
+    if (m_current != npos) {
+      submit(m_current);
+      io_uring_submit(&m_ring);
+    }
+    m_current = m_current == npos ? 0 : (m_current + 1) % m_slots.size();
+    auto &slot = m_slots[m_current];
+    while (slot.pending) {
+      complete_one();
+    }
+    return {slot.data.get(), slot.size};
+  }
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  struct slot_type {
+    aligned_buffer data;
+    std::size_t offset = 0;
+    std::size_t size   = 0;
+    bool pending       = false;
+  };
+
+  uring_prefetcher(int fd, std::size_t file_size, std::size_t chunk_size,
+                   std::size_t depth) :
+    m_fd{fd}, m_file_size{file_size}, m_chunk_size{chunk_size}, m_slots(depth) {
+    m_initialized =
+      io_uring_queue_init(static_cast<unsigned>(depth), &m_ring, 0) == 0;
+    if (!m_initialized) {
+      return;
+    }
+    for (std::size_t index = 0; index != m_slots.size(); ++index) {
+      m_slots[index].data = make_aligned_buffer(chunk_size);
+      submit(index);
+    }
+    io_uring_submit(&m_ring);
+  }
+
+  void submit(std::size_t index) {
+    auto &slot  = m_slots[index];
+    slot.offset = m_next_offset;
+    slot.size   = std::min(m_chunk_size, m_file_size - slot.offset);
+    m_next_offset += slot.size;
+    if (slot.size == 0) {
+      return;
+    }
+    io_uring_sqe *sqe = io_uring_get_sqe(&m_ring);
+    io_uring_prep_read(sqe, m_fd, slot.data.get(),
+                       static_cast<unsigned>(slot.size), slot.offset);
+    io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(index));
+    slot.pending = true;
+  }
+
+  void complete_one() {
+    io_uring_cqe *cqe = nullptr;
+    if (const int error = io_uring_wait_cqe(&m_ring, &cqe); error == -EINTR) {
+      return;
+    } else if (error < 0) {
+      // the ring is unusable, end the file at the current block
+      for (auto &slot : m_slots) {
+        slot.pending = false;
+        slot.size    = 0;
+      }
+      return;
+    }
+    auto &slot =
+      m_slots[reinterpret_cast<std::uintptr_t>(io_uring_cqe_get_data(cqe))];
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&m_ring, cqe);
+    slot.pending = false;
+    if (result < 0) {
+      // surface read errors as the end of the file
+      slot.size     = 0;
+      m_next_offset = m_file_size;
+      return;
+    }
+    // short reads are rare for regular files, finish them synchronously
+    for (auto done = static_cast<std::size_t>(result); done < slot.size;) {
+      const auto bytes = ::pread(m_fd, slot.data.get() + done, slot.size - done,
+                                 static_cast<off_t>(slot.offset + done));
+      if (bytes <= 0) {
+        slot.size = done;
+        break;
+      }
+      done += static_cast<std::size_t>(bytes);
+    }
+  }
+
+  int m_fd;
+  io_uring m_ring;
+  bool m_initialized = false;
+  std::size_t m_file_size;
+  std::size_t m_chunk_size;
+  std::vector<slot_type> m_slots;
+  std::size_t m_next_offset = 0;
+  std::size_t m_current     = npos;
+};
+#endif
+
+class read_ahead_source {
+public:
+  read_ahead_source(std::string path, std::size_t chunk_size,
+                    std::size_t depth) :
+    m_path{std::move(path)},
+    m_chunk_size{std::max<std::size_t>(chunk_size, 1)},
+    m_depth{std::max<std::size_t>(depth, 2)} {}
+
+  void open() {
+    // a small file needs neither full sized buffers nor more of them than it
+    // has chunks, plus the empty one which ends it
+    auto chunk_size = m_chunk_size;
+    auto depth      = m_depth;
+    std::error_code error;
+    if (const auto size = std::filesystem::file_size(m_path, error); !error) {
+      chunk_size = static_cast<std::size_t>(
+        std::clamp<std::uintmax_t>(size, 1, m_chunk_size));
+      const auto chunks = (size + chunk_size - 1) / chunk_size;
+      depth = static_cast<std::size_t>(
+        std::min<std::uintmax_t>(m_depth, chunks + 1));
+    }
+#ifdef UTILITY_HAS_LIBURING
+    m_prefetcher = uring_prefetcher::create(m_path, chunk_size, depth);
+    if (m_prefetcher) {
+      return;
+    }
+#endif
+    m_prefetcher =
+      std::make_unique<threaded_prefetcher>(m_path, chunk_size, depth);
+  }
+
+  byte_span next() { return m_prefetcher->next(); }
+
+private:
+  std::string m_path;
+  std::size_t m_chunk_size;
+  std::size_t m_depth;
+  std::unique_ptr<prefetcher> m_prefetcher;
+};
+
+} // namespace detail
+
+// same blocks as file_chunks_view, but up to `depth - 1` blocks are read
+// ahead while the consumer processes the current one, so that I/O and
+// computation overlap. reads go through io_uring when available, through a
+// background thread shared by every view otherwise. buffers of files smaller
+// than `chunk_size` are only as large as the file.
+using read_ahead_view = chunk_view<detail::read_ahead_source>;
+
+namespace views {
+
+struct read_ahead_fn {
+  read_ahead_view operator()(std::string path,
+                             std::size_t chunk_size = default_chunk_size,
+                             std::size_t depth      = 4) const {
+    return read_ahead_view{std::in_place, std::move(path), chunk_size, depth};
+  }
+};
+
+inline constexpr read_ahead_fn read_ahead;
+
+} // namespace views
+
+} // namespace utility
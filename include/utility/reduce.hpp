@@ -0,0 +1,77 @@
+#pragma once
+#include "utility/execution.hpp"
+#include "utility/functional.hpp"
+#include "utility/thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace utility {
+
+namespace detail {
+// the split only depends on the size, so that results do not depend on the
+// number of threads, even for non associative operations such as floating
+// point addition
+inline std::ptrdiff_t chunk_count(std::ptrdiff_t size) {
+  constexpr std::ptrdiff_t min_chunk_size = 1 << 14;
+  constexpr std::ptrdiff_t max_chunks     = 256;
+  return std::clamp<std::ptrdiff_t>(size / min_chunk_size, 1, max_chunks);
+}
+} // namespace detail
+
+template <typename Rng, typename T, typename Op, typename F>
+T transform_reduce(execution::sequenced_policy, Rng &&rng, T init, Op op,
+                   F f) {
+  for (auto &&element : rng) {
+    init = op(std::move(init), f(std::forward<decltype(element)>(element)));
+  }
+  return init;
+}
+
+// reduces a sized random access range, such as `iota | transform`, split into
+// contiguous chunks processed on the policy thread pool. the range itself is
+// never materialized. partial results are combined in the order of the
+// chunks.
+template <typename Rng, typename T, typename Op, typename F>
+T transform_reduce(execution::parallel_policy policy, Rng &&rng, T init,
+                   Op op, F f) {
+  const auto first = std::begin(rng);
+  const auto size  = static_cast<std::ptrdiff_t>(std::end(rng) - first);
+  if (size == 0) {
+    return init;
+  }
+
+  const auto chunks = detail::chunk_count(size);
+  std::vector<std::optional<T>> partials(static_cast<std::size_t>(chunks));
+  task_group group{policy.pool()};
+  for (std::ptrdiff_t chunk = 0; chunk != chunks; ++chunk) {
+    group.run([&, chunk] {
+      auto it         = first + chunk * size / chunks;
+      const auto last = first + (chunk + 1) * size / chunks;
+      T partial       = f(*it);
+      while (++it != last) {
+        partial = op(std::move(partial), f(*it));
+      }
+      partials[static_cast<std::size_t>(chunk)] = std::move(partial);
+    });
+  }
+  group.wait();
+
+  for (auto &partial : partials) {
+    init = op(std::move(init), std::move(*partial));
+  }
+  return init;
+}
+
+template <typename Policy, typename Rng, typename T, typename Op = std::plus<>>
+T reduce(Policy policy, Rng &&rng, T init, Op op = {}) {
+  return utility::transform_reduce(policy, std::forward<Rng>(rng),
+                                   std::move(init), std::move(op),
+                                   detail::identity{});
+}
+
+} // namespace utility
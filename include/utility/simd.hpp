@@ -0,0 +1,248 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__AVX2__)
+#define UTILITY_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)                                    \
+  || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTILITY_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// simd::length reads whole aligned blocks, past the end of the string
+#if defined(__GNUC__) || defined(__clang__)
+#define UTILITY_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define UTILITY_NO_SANITIZE_ADDRESS
+#endif
+
+namespace utility::simd {
+
+namespace detail {
+// a byte lane can count up to 255 matches before it wraps
+constexpr std::ptrdiff_t max_inner_iterations = 255;
+
+// simd::length scans groups of four aligned blocks at once
+constexpr std::uintptr_t blocks_per_group = 4;
+
+#if defined(UTILITY_SIMD_AVX2)
+using block_type = __m256i;
+
+// the bits of the null bytes of an aligned block
+UTILITY_NO_SANITIZE_ADDRESS inline std::uint32_t
+null_mask(const block_type *block) {
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+    _mm256_cmpeq_epi8(_mm256_load_si256(block), _mm256_setzero_si256())));
+}
+
+// whether a group of aligned blocks has a null byte
+UTILITY_NO_SANITIZE_ADDRESS inline bool has_null(const block_type *group) {
+  const __m256i low  = _mm256_min_epu8(group[0], group[1]);
+  const __m256i high = _mm256_min_epu8(group[2], group[3]);
+  return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(low, high),
+                                                _mm256_setzero_si256()))
+         != 0;
+}
+#elif defined(UTILITY_SIMD_SSE2)
+using block_type = __m128i;
+
+UTILITY_NO_SANITIZE_ADDRESS inline std::uint32_t
+null_mask(const block_type *block) {
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(
+    _mm_cmpeq_epi8(_mm_load_si128(block), _mm_setzero_si128())));
+}
+
+UTILITY_NO_SANITIZE_ADDRESS inline bool has_null(const block_type *group) {
+  const __m128i low  = _mm_min_epu8(group[0], group[1]);
+  const __m128i high = _mm_min_epu8(group[2], group[3]);
+  return _mm_movemask_epi8(
+           _mm_cmpeq_epi8(_mm_min_epu8(low, high), _mm_setzero_si128()))
+         != 0;
+}
+#endif
+} // namespace detail
+
+// counts the occurrences of `value` in [first, last)
+inline std::ptrdiff_t count(const char *first, const char *last, char value) {
+  std::ptrdiff_t total = 0;
+
+#if defined(UTILITY_SIMD_AVX2)
+  constexpr std::ptrdiff_t width = sizeof(__m256i);
+  const __m256i needle           = _mm256_set1_epi8(value);
+  while (last - first >= width) {
+    const auto blocks =
+      std::min((last - first) / width, detail::max_inner_iterations);
+    const char *block_end = first + blocks * width;
+    __m256i counters      = _mm256_setzero_si256();
+    for (; first != block_end; first += width) {
+      const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+      // matching lanes are all ones, i.e. -1
+      counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(chunk, needle));
+    }
+    alignas(__m256i) std::uint64_t sums[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(sums),
+                       _mm256_sad_epu8(counters, _mm256_setzero_si256()));
+    total += static_cast<std::ptrdiff_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+  }
+#elif defined(UTILITY_SIMD_SSE2)
+  constexpr std::ptrdiff_t width = sizeof(__m128i);
+  const __m128i needle           = _mm_set1_epi8(value);
+  while (last - first >= width) {
+    const auto blocks =
+      std::min((last - first) / width, detail::max_inner_iterations);
+    const char *block_end = first + blocks * width;
+    __m128i counters      = _mm_setzero_si128();
+    for (; first != block_end; first += width) {
+      const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+      // matching lanes are all ones, i.e. -1
+      counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(chunk, needle));
+    }
+    alignas(__m128i) std::uint64_t sums[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(sums),
+                    _mm_sad_epu8(counters, _mm_setzero_si128()));
+    total += static_cast<std::ptrdiff_t>(sums[0] + sums[1]);
+  }
+#endif
+
+  // scalar tail
+  return total + std::count(first, last, value);
+}
+
+// returns a pointer to the first occurrence of `value` in [first, last), or
+// `last` if there is none
+inline const char *find(const char *first, const char *last, char value) {
+#if defined(UTILITY_SIMD_AVX2)
+  constexpr std::ptrdiff_t width = sizeof(__m256i);
+  const __m256i needle           = _mm256_set1_epi8(value);
+  for (; last - first >= width; first += width) {
+    const __m256i chunk =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+    if (const auto mask = static_cast<std::uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)))) {
+      return first + std::countr_zero(mask);
+    }
+  }
+#elif defined(UTILITY_SIMD_SSE2)
+  constexpr std::ptrdiff_t width = sizeof(__m128i);
+  const __m128i needle           = _mm_set1_epi8(value);
+  for (; last - first >= width; first += width) {
+    const __m128i chunk =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+    if (const auto mask = static_cast<std::uint32_t>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))) {
+      return first + std::countr_zero(mask);
+    }
+  }
+#endif
+
+  // scalar tail
+  const void *found =
+    first == last
+      ? nullptr
+      : std::memchr(first, value, static_cast<std::size_t>(last - first));
+  return found ? static_cast<const char *>(found) : last;
+}
+
+// the number of characters compared at once by equal_mask and any_of_mask
+#if defined(UTILITY_SIMD_AVX2)
+constexpr std::ptrdiff_t block_size = sizeof(__m256i);
+#elif defined(UTILITY_SIMD_SSE2)
+constexpr std::ptrdiff_t block_size = sizeof(__m128i);
+#else
+constexpr std::ptrdiff_t block_size = 1;
+#endif
+
+// the bits of the characters of the block at `first` which are equal to
+// `value`, bit i for first[i]
+inline std::uint32_t equal_mask(const char *first, char value) {
+#if defined(UTILITY_SIMD_AVX2)
+  const __m256i chunk =
+    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+  return static_cast<std::uint32_t>(
+    _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(value))));
+#elif defined(UTILITY_SIMD_SSE2)
+  const __m128i chunk =
+    _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+  return static_cast<std::uint32_t>(
+    _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(value))));
+#else
+  return *first == value;
+#endif
+}
+
+// the bits of the characters of the block at `first` which are one of `set`.
+// the block is compared with each character of the set, which suits small
+// sets, such as whitespace.
+inline std::uint32_t any_of_mask(const char *first, std::string_view set) {
+#if defined(UTILITY_SIMD_AVX2)
+  const __m256i chunk =
+    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+  __m256i matches = _mm256_setzero_si256();
+  for (const char c : set) {
+    matches =
+      _mm256_or_si256(matches, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c)));
+  }
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+#elif defined(UTILITY_SIMD_SSE2)
+  const __m128i chunk =
+    _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+  __m128i matches     = _mm_setzero_si128();
+  for (const char c : set) {
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)));
+  }
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+#else
+  return set.find(*first) != std::string_view::npos;
+#endif
+}
+
+// returns the number of characters before the first null character at `str`,
+// like std::strlen. blocks are loaded from aligned addresses, so a block which
+// extends past the terminator never crosses into the next page.
+UTILITY_NO_SANITIZE_ADDRESS inline std::size_t length(const char *str) {
+#if defined(UTILITY_SIMD_AVX2) || defined(UTILITY_SIMD_SSE2)
+  using detail::block_type;
+  constexpr std::uintptr_t width = sizeof(block_type);
+  const auto address             = reinterpret_cast<std::uintptr_t>(str);
+  const auto offset              = address % width;
+  const auto *block = reinterpret_cast<const block_type *>(address - offset);
+
+  auto position = [str](const block_type *found, std::uint32_t mask) {
+    return static_cast<std::size_t>(reinterpret_cast<const char *>(found) - str
+                                    + std::countr_zero(mask));
+  };
+
+  // the bytes of the first block before `str` are not part of the string
+  if (const auto mask = detail::null_mask(block) >> offset) {
+    return static_cast<std::size_t>(std::countr_zero(mask));
+  }
+  // single blocks up to the first aligned group, then whole groups
+  while (reinterpret_cast<std::uintptr_t>(++block)
+           % (width * detail::blocks_per_group)
+         != 0) {
+    if (const auto mask = detail::null_mask(block)) {
+      return position(block, mask);
+    }
+  }
+  while (!detail::has_null(block)) {
+    block += detail::blocks_per_group;
+  }
+  for (;; ++block) {
+    if (const auto mask = detail::null_mask(block)) {
+      return position(block, mask);
+    }
+  }
+#else
+  return std::strlen(str);
+#endif
+}
+
+} // namespace utility::simd
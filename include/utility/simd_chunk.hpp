@@ -0,0 +1,264 @@
+#pragma once
+
+#if __has_include(<experimental/simd>)
+#define UTILITY_HAS_STD_SIMD 1
+#include "utility/ranges.hpp"
+#include <cstddef>
+#include <experimental/simd>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace utility {
+
+namespace simd {
+
+namespace stdx = std::experimental;
+
+// a native width simd value, together with the mask of the lanes which hold
+// actual elements. only the last batch of a range has inactive lanes.
+// arithmetic applies to all lanes but the inactive divisors, and keeps the
+// mask, so that a generic lambda such as `[](auto x) { return x * x; }`
+// works on batches as well.
+template <typename T> struct batch {
+  using simd_type = stdx::native_simd<T>;
+  using mask_type = typename simd_type::mask_type;
+
+  static constexpr std::size_t width = simd_type::size();
+
+  simd_type values;
+  mask_type mask;
+};
+
+#define UTILITY_BATCH_OPERATOR(op)                                             \
+  template <typename T>                                                        \
+  batch<T> operator op(const batch<T> &lhs, const batch<T> &rhs) {             \
+    return {lhs.values op rhs.values, lhs.mask && rhs.mask};                   \
+  }                                                                            \
+  template <typename T, typename U,                                            \
+            typename = std::enable_if_t<std::is_arithmetic_v<U>>>              \
+  batch<T> operator op(const batch<T> &lhs, U rhs) {                           \
+    return {lhs.values op static_cast<T>(rhs), lhs.mask};                      \
+  }                                                                            \
+  template <typename T, typename U,                                            \
+            typename = std::enable_if_t<std::is_arithmetic_v<U>>>              \
+  batch<T> operator op(U lhs, const batch<T> &rhs) {                           \
+    return {static_cast<T>(lhs) op rhs.values, rhs.mask};                      \
+  }
+
+UTILITY_BATCH_OPERATOR(+)
+UTILITY_BATCH_OPERATOR(-)
+UTILITY_BATCH_OPERATOR(*)
+
+#undef UTILITY_BATCH_OPERATOR
+
+// inactive lanes are divided by one instead, so that dividing by a partial
+// batch does not divide integers by zero
+template <typename T>
+typename batch<T>::simd_type divisor(const batch<T> &b,
+                                     const typename batch<T>::mask_type &mask) {
+  auto values = b.values;
+  stdx::where(!mask, values) = T{1};
+  return values;
+}
+
+template <typename T>
+batch<T> operator/(const batch<T> &lhs, const batch<T> &rhs) {
+  const auto mask = lhs.mask && rhs.mask;
+  return {lhs.values / divisor(rhs, mask), mask};
+}
+
+template <typename T, typename U,
+          typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+batch<T> operator/(const batch<T> &lhs, U rhs) {
+  return {lhs.values / static_cast<T>(rhs), lhs.mask};
+}
+
+template <typename T, typename U,
+          typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+batch<T> operator/(U lhs, const batch<T> &rhs) {
+  return {static_cast<T>(lhs) / divisor(rhs, rhs.mask), rhs.mask};
+}
+
+// sums a range of batches, lane-wise first and horizontally once at the end
+template <typename Rng, typename U> U accumulate(Rng &&rng, U init) {
+  using batch_type = std::decay_t<decltype(*std::begin(rng))>;
+  using simd_type  = typename batch_type::simd_type;
+  simd_type sums   = 0;
+  for (auto &&b : rng) {
+    if (stdx::all_of(b.mask)) {
+      sums += b.values;
+    } else {
+      stdx::where(b.mask, sums) += b.values;
+    }
+  }
+  return init + static_cast<U>(stdx::reduce(sums));
+}
+
+} // namespace simd
+
+namespace detail::simd_chunk {
+template <typename Rng, typename = void> constexpr bool is_contiguous = false;
+
+template <typename Rng>
+constexpr bool is_contiguous<
+  Rng, std::void_t<decltype(std::data(std::declval<Rng &>()))>> = true;
+
+// the elements of a range, loaded directly from contiguous ranges, read
+// through the iterators of the others
+template <typename Rng> auto first(Rng &rng) {
+  if constexpr (is_contiguous<Rng>) {
+    return std::data(rng);
+  } else {
+    return std::begin(rng);
+  }
+}
+
+template <typename Rng> std::ptrdiff_t size(Rng &rng) {
+  return static_cast<std::ptrdiff_t>(std::end(rng) - std::begin(rng));
+}
+} // namespace detail::simd_chunk
+
+// splits a sized random access range into simd::batch values. the elements
+// are read from `I`, which either comes from a range the view refers to, or,
+// when `Base` is not void, from the range the view owns.
+template <typename I, typename Base = void>
+class simd_chunk_view : public ranges::view_base {
+public:
+  using value_type =
+    std::remove_cv_t<typename std::iterator_traits<I>::value_type>;
+  using batch_type  = simd::batch<value_type>;
+  using source_type = std::conditional_t<std::is_void_v<Base>, I, Base>;
+
+  class iterator {
+  public:
+    using iterator_concept  = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = batch_type;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = batch_type;
+
+    iterator() = default;
+
+    reference operator*() const {
+      using simd_type      = typename batch_type::simd_type;
+      using mask_type      = typename batch_type::mask_type;
+      constexpr auto width = static_cast<std::ptrdiff_t>(batch_type::width);
+      const auto remaining = m_size - m_offset;
+      if (remaining >= width) {
+        if constexpr (std::is_pointer_v<I>) {
+          return {simd_type{m_first + m_offset, simd::stdx::element_aligned},
+                  mask_type{true}};
+        } else {
+          return {simd_type{[this](auto lane) {
+                    return static_cast<simd_view_value>(
+                      m_first[m_offset + static_cast<std::ptrdiff_t>(lane)]);
+                  }},
+                  mask_type{true}};
+        }
+      }
+      // the last batch is partial, inactive lanes are zero
+      const simd_type lanes{[](auto lane) { return lane; }};
+      return {simd_type{[this, remaining](auto lane) {
+                const auto index = static_cast<std::ptrdiff_t>(lane);
+                return index < remaining ? static_cast<simd_view_value>(
+                                             m_first[m_offset + index])
+                                         : simd_view_value{};
+              }},
+              lanes < static_cast<simd_view_value>(remaining)};
+    }
+
+    iterator &operator++() {
+      m_offset += static_cast<std::ptrdiff_t>(batch_type::width);
+      if (m_offset > m_size) {
+        m_offset = m_size;
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const iterator &lhs, const iterator &rhs) {
+      return lhs.m_offset == rhs.m_offset;
+    }
+    friend bool operator!=(const iterator &lhs, const iterator &rhs) {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend simd_chunk_view;
+    using simd_view_value = simd_chunk_view::value_type;
+
+    iterator(I first, std::ptrdiff_t offset, std::ptrdiff_t size) :
+      m_first{first}, m_offset{offset}, m_size{size} {}
+
+    I m_first{};
+    std::ptrdiff_t m_offset = 0;
+    std::ptrdiff_t m_size   = 0;
+  };
+
+  simd_chunk_view() = default;
+
+  simd_chunk_view(source_type source, std::ptrdiff_t size) :
+    m_source{std::move(source)}, m_size{size} {}
+
+  iterator begin() const { return {first(), 0, m_size}; }
+  iterator end() const { return {first(), m_size, m_size}; }
+
+  std::size_t size() const noexcept {
+    constexpr auto width = static_cast<std::ptrdiff_t>(batch_type::width);
+    return static_cast<std::size_t>((m_size + width - 1) / width);
+  }
+
+private:
+  // iterators into an owned range are taken from the copy of this view, not
+  // from the one it was copied from
+  I first() const {
+    if constexpr (std::is_void_v<Base>) {
+      return m_source;
+    } else {
+      return detail::simd_chunk::first(m_source);
+    }
+  }
+
+  source_type m_source{};
+  std::ptrdiff_t m_size = 0;
+};
+
+namespace views {
+
+struct simd_chunk_fn {
+  // contiguous ranges are loaded directly, other sized random access ranges
+  // are read through their iterators. the view refers to an lvalue range,
+  // which must outlive it, and owns an rvalue one: the iterators of views
+  // such as a transform point back at their view.
+  template <typename Rng> auto operator()(Rng &&rng) const {
+    using utility::detail::simd_chunk::first;
+    using utility::detail::simd_chunk::size;
+    if constexpr (std::is_lvalue_reference_v<Rng>) {
+      return simd_chunk_view<decltype(first(rng))>{first(rng), size(rng)};
+    } else {
+      using base_type = std::remove_cv_t<Rng>;
+      const auto n    = size(rng);
+      return simd_chunk_view<decltype(first(std::declval<const base_type &>())),
+                             base_type>{std::move(rng), n};
+    }
+  }
+
+  template <typename Rng>
+  friend auto operator|(Rng &&rng, simd_chunk_fn simd_chunk) {
+    return simd_chunk(std::forward<Rng>(rng));
+  }
+};
+
+inline constexpr simd_chunk_fn simd_chunk;
+
+} // namespace views
+
+} // namespace utility
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+#include "utility/functional.hpp"
+#include "utility/pdq_sort.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utility {
+
+namespace detail {
+template <typename Container, typename Comp, typename = void>
+constexpr bool has_member_sort = false;
+
+template <typename Container, typename Comp>
+constexpr bool has_member_sort<
+  Container, Comp,
+  std::void_t<decltype(std::declval<Container &>().sort(
+    std::declval<Comp>()))>> = true;
+} // namespace detail
+
+// sorts a forward range according to `comp` applied to the projections of
+// its elements:
+// - node based containers, such as std::list, are merge sorted by relinking
+//   their nodes, without moving any element
+// - random access ranges are sorted in place with pdq_sort
+// - other ranges are moved into a contiguous buffer, sorted there and moved
+//   back
+template <typename Rng, typename Comp = std::less<>,
+          typename Proj = detail::identity>
+void sort(Rng &&rng, Comp comp = {}, Proj proj = {}) {
+  detail::projected_compare<Comp, Proj> compare{std::move(comp),
+                                                std::move(proj)};
+  if constexpr (std::is_lvalue_reference_v<Rng>
+                && detail::has_member_sort<std::remove_reference_t<Rng>,
+                                           decltype(compare)>) {
+    rng.sort(compare);
+  } else {
+    auto first      = std::begin(rng);
+    const auto last = std::end(rng);
+    using I         = decltype(first);
+    if constexpr (std::random_access_iterator<I>
+                  && std::is_same_v<I, std::remove_const_t<decltype(last)>>) {
+      utility::pdq_sort(rng, std::move(compare.comp), std::move(compare.proj));
+    } else {
+      std::vector<std::iter_value_t<I>> buffer;
+      if constexpr (std::sized_sentinel_for<decltype(last), I>) {
+        buffer.reserve(static_cast<std::size_t>(last - first));
+      }
+      for (auto it = first; it != last; ++it) {
+        buffer.push_back(std::ranges::iter_move(it));
+      }
+      utility::pdq_sort(buffer, std::move(compare.comp),
+                        std::move(compare.proj));
+      for (auto &value : buffer) {
+        *first = std::move(value);
+        ++first;
+      }
+    }
+  }
+}
+
+} // namespace utility
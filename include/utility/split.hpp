@@ -0,0 +1,329 @@
+#pragma once
+#include "utility/ranges.hpp"
+#include "utility/simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utility {
+
+// the characters a text is split on by views::split when any one of them is
+// a delimiter, e.g. `any_of{" \t\n"}`
+struct any_of {
+  std::string_view chars;
+};
+
+namespace detail::split {
+// a delimiter spans size() characters. candidates() finds the positions of
+// a block where it may start, reading size() - 1 characters past the block,
+// which verify() confirms. matches() checks any position, with size()
+// characters left.
+
+struct char_delimiter {
+  char value;
+
+  std::ptrdiff_t size() const { return 1; }
+  std::uint32_t candidates(const char *first) const {
+    return simd::equal_mask(first, value);
+  }
+  bool verify(const char *) const { return true; }
+  bool matches(const char *position) const { return *position == value; }
+};
+
+// the first and last characters of the delimiter are compared a block at a
+// time, the others at the positions where both match
+struct string_delimiter {
+  std::string_view value;
+
+  std::ptrdiff_t size() const {
+    return static_cast<std::ptrdiff_t>(value.size());
+  }
+  std::uint32_t candidates(const char *first) const {
+    return simd::equal_mask(first, value.front())
+           & simd::equal_mask(first + size() - 1, value.back());
+  }
+  bool verify(const char *position) const {
+    return value.size() <= 2
+           || std::memcmp(position + 1, value.data() + 1, value.size() - 2)
+                == 0;
+  }
+  bool matches(const char *position) const {
+    return *position == value.front()
+           && position[size() - 1] == value.back() && verify(position);
+  }
+};
+
+struct any_of_delimiter {
+  std::string_view chars;
+
+  std::ptrdiff_t size() const { return 1; }
+  std::uint32_t candidates(const char *first) const {
+    return simd::any_of_mask(first, chars);
+  }
+  bool verify(const char *) const { return true; }
+  bool matches(const char *position) const {
+    return chars.find(*position) != std::string_view::npos;
+  }
+};
+
+// finds the delimiters of [first, last), from left to right. the candidates
+// of a whole block are found at once, then consumed one delimiter at a time,
+// so that a block holding several short pieces is loaded only once.
+template <typename Delimiter> class searcher {
+public:
+  searcher() = default;
+
+  searcher(const char *first, const char *last, Delimiter delimiter) :
+    m_block{first}, m_last{last}, m_delimiter{delimiter} {
+    load();
+  }
+
+  const Delimiter &delimiter() const { return m_delimiter; }
+
+  // the first delimiter at or after `first`, or the end of the text
+  const char *find(const char *first) {
+    if (!m_tail) {
+      do {
+        // the candidates before `first` were part of the previous piece or
+        // of the previous delimiter
+        const auto offset = first - m_block;
+        if (offset >= simd::block_size) {
+          m_mask = 0;
+        } else if (offset > 0) {
+          m_mask &= ~std::uint32_t{0} << offset;
+        }
+        while (m_mask != 0) {
+          const auto *candidate = m_block + std::countr_zero(m_mask);
+          m_mask &= m_mask - 1;
+          if (m_delimiter.verify(candidate)) {
+            return candidate;
+          }
+        }
+        m_block += simd::block_size;
+      } while (load());
+    }
+    // what is left is shorter than a block, checked one position at a time
+    for (const auto *it = std::max(first, m_block);
+         m_last - it >= m_delimiter.size(); ++it) {
+      if (m_delimiter.matches(it)) {
+        return it;
+      }
+    }
+    return m_last;
+  }
+
+private:
+  bool load() {
+    m_tail = m_last - m_block < simd::block_size + m_delimiter.size() - 1;
+    if (!m_tail) {
+      m_mask = m_delimiter.candidates(m_block);
+    }
+    return !m_tail;
+  }
+
+  const char *m_block = nullptr;
+  const char *m_last  = nullptr;
+  std::uint32_t m_mask = 0;
+  bool m_tail          = true;
+  Delimiter m_delimiter{};
+};
+
+template <typename Char>
+constexpr bool is_narrow_char =
+  std::is_same_v<Char, char> || std::is_same_v<Char, char8_t>;
+} // namespace detail::split
+
+// forward range of the pieces of a contiguous character buffer between
+// delimiters, as string views into the buffer. like std::views::split, n
+// delimiters make n + 1 pieces, some of which may be empty, and an empty
+// buffer has no pieces. delimiters are searched for a block at a time.
+template <typename Char, typename Delimiter>
+class split_view : public ranges::view_base {
+public:
+  class iterator {
+  public:
+    using iterator_concept  = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::basic_string_view<Char>;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::basic_string_view<Char>;
+
+    iterator() = default;
+
+    reference operator*() const {
+      return {reinterpret_cast<const Char *>(m_piece),
+              static_cast<std::size_t>(m_piece_end - m_piece)};
+    }
+
+    iterator &operator++() {
+      if (m_piece_end == m_end) {
+        m_piece    = m_end;
+        m_trailing = false;
+      } else {
+        m_piece = m_piece_end + m_searcher.delimiter().size();
+        // a delimiter at the end of the buffer is followed by an empty piece
+        m_trailing  = m_piece == m_end;
+        m_piece_end = m_searcher.find(m_piece);
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const iterator &lhs, const iterator &rhs) {
+      return lhs.m_piece == rhs.m_piece && lhs.m_trailing == rhs.m_trailing;
+    }
+    friend bool operator!=(const iterator &lhs, const iterator &rhs) {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend split_view;
+
+    iterator(const char *piece, const char *end, Delimiter delimiter) :
+      m_piece{piece}, m_end{end}, m_searcher{piece, end, delimiter} {
+      m_piece_end = m_searcher.find(m_piece);
+    }
+
+    const char *m_piece     = nullptr;
+    const char *m_piece_end = nullptr;
+    const char *m_end       = nullptr;
+    bool m_trailing         = false;
+    detail::split::searcher<Delimiter> m_searcher;
+  };
+
+  split_view() = default;
+
+  split_view(std::basic_string_view<Char> text, Delimiter delimiter) :
+    m_text{text}, m_delimiter{delimiter} {}
+
+  iterator begin() const {
+    return {data(), data() + m_text.size(), m_delimiter};
+  }
+
+  iterator end() const {
+    const auto last = data() + m_text.size();
+    return {last, last, m_delimiter};
+  }
+
+  bool empty() const noexcept { return m_text.empty(); }
+
+private:
+  const char *data() const {
+    return reinterpret_cast<const char *>(m_text.data());
+  }
+
+  std::basic_string_view<Char> m_text;
+  Delimiter m_delimiter{};
+};
+
+namespace detail::split {
+// the delimiter is not deduced, so that anything convertible to a string
+// view of the characters of the text is a string delimiter
+template <typename Char, typename = std::enable_if_t<is_narrow_char<Char>>>
+auto make_split(std::basic_string_view<Char> text,
+                std::type_identity_t<Char> delimiter) {
+  return split_view<Char, char_delimiter>{text, {static_cast<char>(delimiter)}};
+}
+
+// an empty string has no first and last characters to search for
+template <typename Char, typename = std::enable_if_t<is_narrow_char<Char>>>
+auto make_split(std::basic_string_view<Char> text,
+                std::type_identity_t<std::basic_string_view<Char>> delimiter) {
+  if (delimiter.empty()) {
+    throw std::invalid_argument{"split on an empty string"};
+  }
+  const std::string_view chars{reinterpret_cast<const char *>(delimiter.data()),
+                               delimiter.size()};
+  return split_view<Char, string_delimiter>{text, {chars}};
+}
+
+template <typename Char, typename = std::enable_if_t<is_narrow_char<Char>>>
+auto make_split(std::basic_string_view<Char> text, any_of delimiter) {
+  return split_view<Char, any_of_delimiter>{text, {delimiter.chars}};
+}
+
+// anything with contiguous `data()` and `size()`: strings, string views,
+// vectors of char, mapped files...
+template <typename Text>
+auto text_view(const Text &text)
+  -> decltype(std::basic_string_view{text.data(), text.size()}) {
+  return {text.data(), text.size()};
+}
+
+template <typename Char, std::size_t N>
+std::basic_string_view<Char> text_view(const Char (&text)[N]) {
+  return {text, N - 1};
+}
+
+// the pieces are views into the text, a temporary string or vector would
+// leave them dangling
+template <typename Text> constexpr bool is_owning_text = false;
+
+template <typename Char, typename Traits, typename Alloc>
+constexpr bool is_owning_text<std::basic_string<Char, Traits, Alloc>> = true;
+
+template <typename T, typename Alloc>
+constexpr bool is_owning_text<std::vector<T, Alloc>> = true;
+
+template <typename Text>
+using if_owning_rvalue =
+  std::enable_if_t<is_owning_text<std::remove_cv_t<Text>>>;
+
+template <typename Delimiter> struct split_closure {
+  Delimiter delimiter;
+
+  template <typename Text>
+  friend auto operator|(const Text &text, const split_closure &split)
+    -> decltype(make_split(text_view(text), split.delimiter)) {
+    return make_split(text_view(text), split.delimiter);
+  }
+
+  template <typename Text>
+  friend auto operator|(Text &&, const split_closure &)
+    -> if_owning_rvalue<Text> = delete;
+};
+} // namespace detail::split
+
+namespace views {
+
+struct split_fn {
+  // a text of char or char8_t, split on a character, on a non empty string or
+  // on any_of a set of characters. throws std::invalid_argument on an empty
+  // string.
+  template <typename Text, typename Delimiter>
+  auto operator()(const Text &text, Delimiter delimiter) const
+    -> decltype(detail::split::make_split(detail::split::text_view(text),
+                                          delimiter)) {
+    return detail::split::make_split(detail::split::text_view(text),
+                                     delimiter);
+  }
+
+  template <typename Text, typename Delimiter>
+  auto operator()(Text &&, Delimiter) const
+    -> detail::split::if_owning_rvalue<Text> = delete;
+
+  // `text | views::split(delimiter)`
+  template <typename Delimiter> auto operator()(Delimiter delimiter) const {
+    return detail::split::split_closure<Delimiter>{delimiter};
+  }
+};
+
+inline constexpr split_fn split;
+
+} // namespace views
+
+} // namespace utility
@@ -0,0 +1,127 @@
+#pragma once
+#include "utility/simd.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace utility {
+
+// the white space of the "C" locale
+inline bool is_space(char c) {
+  return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+}
+
+// the statistics reported by wc: lines are counted by their '\n', words are
+// maximal runs of characters other than ' ', '\t', '\n', '\v', '\f' and '\r',
+// line lengths are in bytes, without the '\n'.
+struct text_stats {
+  int64_t lines           = 0;
+  int64_t words           = 0;
+  int64_t bytes           = 0;
+  int64_t max_line_length = 0;
+};
+
+// computes all of text_stats in a single pass over one or more consecutive
+// blocks of text. blocks are classified 32 bytes at a time, the per block
+// bookkeeping only touches the newlines.
+class text_stats_counter {
+public:
+  void operator()(const char *first, const char *last) {
+    for (; last - first >= block_size; first += block_size) {
+      std::uint32_t spaces, newlines;
+      classify_block(first, spaces, newlines);
+      update(spaces, newlines, block_size);
+    }
+    if (first != last) {
+      const auto size = static_cast<int>(last - first);
+      std::uint32_t spaces, newlines;
+      classify_tail(first, size, spaces, newlines);
+      update(spaces, newlines, size);
+    }
+  }
+
+  text_stats result() const {
+    auto stats            = m_stats;
+    stats.max_line_length = std::max(stats.max_line_length, m_line_length);
+    return stats;
+  }
+
+private:
+  static constexpr int block_size = 32;
+
+  // one bit per byte of a 32 bytes block
+  static void classify_block(const char *block, std::uint32_t &spaces,
+                             std::uint32_t &newlines) {
+#if defined(UTILITY_SIMD_AVX2)
+    const __m256i chunk =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    // '\t'..'\r' is a range of 5 characters
+    const __m256i shifted  = _mm256_sub_epi8(chunk, _mm256_set1_epi8('\t'));
+    const __m256i in_range = _mm256_cmpeq_epi8(
+      _mm256_min_epu8(shifted, _mm256_set1_epi8('\r' - '\t')), shifted);
+    const __m256i space = _mm256_or_si256(
+      in_range, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')));
+    spaces   = static_cast<std::uint32_t>(_mm256_movemask_epi8(space));
+    newlines = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n'))));
+#elif defined(UTILITY_SIMD_SSE2)
+    spaces   = 0;
+    newlines = 0;
+    for (int half = 0; half != 2; ++half) {
+      const __m128i chunk = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(block + half * sizeof(__m128i)));
+      // '\t'..'\r' is a range of 5 characters
+      const __m128i shifted  = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+      const __m128i in_range = _mm_cmpeq_epi8(
+        _mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+      const __m128i space =
+        _mm_or_si128(in_range, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')));
+      const auto shift = half * static_cast<int>(sizeof(__m128i));
+      spaces |= static_cast<std::uint32_t>(_mm_movemask_epi8(space)) << shift;
+      newlines |= static_cast<std::uint32_t>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))))
+                  << shift;
+    }
+#else
+    classify_tail(block, block_size, spaces, newlines);
+#endif
+  }
+
+  static void classify_tail(const char *block, int size, std::uint32_t &spaces,
+                            std::uint32_t &newlines) {
+    spaces   = 0;
+    newlines = 0;
+    for (int i = 0; i != size; ++i) {
+      spaces |= std::uint32_t{is_space(block[i])} << i;
+      newlines |= std::uint32_t{block[i] == '\n'} << i;
+    }
+  }
+
+  void update(std::uint32_t spaces, std::uint32_t newlines, int size) {
+    const auto valid =
+      size == block_size ? ~std::uint32_t{0} : (std::uint32_t{1} << size) - 1;
+    const auto letters  = ~spaces & valid;
+    const auto previous = (letters << 1) | std::uint32_t{m_in_word};
+    m_stats.words += std::popcount(letters & ~previous);
+    m_in_word = (letters >> (size - 1)) & 1;
+
+    m_stats.bytes += size;
+    m_stats.lines += std::popcount(newlines);
+
+    int line_start = 0;
+    for (; newlines != 0; newlines &= newlines - 1) {
+      const int position = std::countr_zero(newlines);
+      m_stats.max_line_length = std::max(
+        m_stats.max_line_length, m_line_length + position - line_start);
+      m_line_length = 0;
+      line_start    = position + 1;
+    }
+    m_line_length += size - line_start;
+  }
+
+  text_stats m_stats;
+  int64_t m_line_length = 0;
+  bool m_in_word        = false;
+};
+
+} // namespace utility
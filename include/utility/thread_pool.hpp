@@ -0,0 +1,188 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace utility {
+
+// a fixed size pool of workers, each owning a task queue. workers pop their
+// own queue from the back (LIFO, cache friendly for nested tasks) and steal
+// from the front of the other queues when theirs is empty. a thread waiting
+// for tasks runs them too, so a pool of n workers keeps n + 1 threads busy,
+// and a pool of no worker runs every task on the waiting thread.
+class thread_pool {
+public:
+  explicit thread_pool(
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency())) :
+    m_queues(std::max<std::size_t>(threads, 1)) {
+    for (auto &queue : m_queues) {
+      queue = std::make_unique<task_queue>();
+    }
+    m_threads.reserve(threads);
+    for (std::size_t index = 0; index != threads; ++index) {
+      m_threads.emplace_back([this, index] { work(index); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard lock{m_mutex};
+      m_stop = true;
+    }
+    m_wakeup.notify_all();
+    for (auto &thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  // the number of workers, not counting the waiting thread
+  std::size_t size() const noexcept { return m_threads.size(); }
+
+  // tasks submitted from a worker go to its own queue, other tasks are spread
+  // round robin
+  void submit(std::function<void()> task) {
+    const auto index = current_pool == this
+                         ? current_index
+                         : m_next.fetch_add(1, std::memory_order_relaxed)
+                             % m_queues.size();
+    {
+      std::lock_guard lock{m_queues[index]->mutex};
+      m_queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard lock{m_mutex};
+      ++m_queued;
+    }
+    m_wakeup.notify_one();
+  }
+
+  // runs a single queued task on the calling thread, if there is one
+  bool run_one() {
+    const auto first = current_pool == this ? current_index : 0;
+    std::function<void()> task;
+    if (!pop(first, task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  // helps running tasks until `done()` holds, so that waiting from inside a
+  // task cannot deadlock the pool
+  template <typename Pred> void wait_until(Pred done) {
+    while (!done()) {
+      if (!run_one()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+private:
+  struct task_queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool pop(std::size_t first, std::function<void()> &task) {
+    for (std::size_t offset = 0; offset != m_queues.size(); ++offset) {
+      auto &queue = *m_queues[(first + offset) % m_queues.size()];
+      std::lock_guard lock{queue.mutex};
+      if (queue.tasks.empty()) {
+        continue;
+      }
+      if (offset == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      std::lock_guard count_lock{m_mutex};
+      --m_queued;
+      return true;
+    }
+    return false;
+  }
+
+  void work(std::size_t index) {
+    current_pool  = this;
+    current_index = index;
+    for (;;) {
+      if (run_one()) {
+        continue;
+      }
+      std::unique_lock lock{m_mutex};
+      m_wakeup.wait(lock, [this] { return m_stop || m_queued != 0; });
+      if (m_stop && m_queued == 0) {
+        return;
+      }
+    }
+  }
+
+  static inline thread_local thread_pool *current_pool = nullptr;
+  static inline thread_local std::size_t current_index = 0;
+
+  std::vector<std::unique_ptr<task_queue>> m_queues;
+  std::vector<std::thread> m_threads;
+  std::atomic<std::size_t> m_next{0};
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::size_t m_queued = 0;
+  bool m_stop          = false;
+};
+
+// tracks a set of tasks running on a pool. tasks may add more tasks to the
+// same group. the first exception thrown by a task is rethrown by wait().
+class task_group {
+public:
+  explicit task_group(thread_pool &pool) : m_pool{pool} {}
+
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+
+  ~task_group() {
+    m_pool.wait_until([this] { return m_pending.load() == 0; });
+  }
+
+  template <typename F> void run(F f) {
+    m_pending.fetch_add(1);
+    m_pool.submit([this, f = std::move(f)]() mutable {
+      try {
+        f();
+      } catch (...) {
+        std::lock_guard lock{m_mutex};
+        if (!m_exception) {
+          m_exception = std::current_exception();
+        }
+      }
+      m_pending.fetch_sub(1);
+    });
+  }
+
+  void wait() {
+    m_pool.wait_until([this] { return m_pending.load() == 0; });
+    if (m_exception) {
+      std::rethrow_exception(std::exchange(m_exception, nullptr));
+    }
+  }
+
+private:
+  thread_pool &m_pool;
+  std::atomic<std::size_t> m_pending{0};
+  std::mutex m_mutex;
+  std::exception_ptr m_exception;
+};
+
+} // namespace utility
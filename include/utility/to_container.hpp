@@ -0,0 +1,150 @@
+#pragma once
+#include "utility/ranges.hpp"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+namespace utility {
+
+// the number of elements expected from a range whose size is not known in
+// advance. containers reserve that much up front, then grow geometrically.
+struct size_hint {
+  std::size_t size = 0;
+};
+
+namespace detail::to_container {
+template <typename Rng>
+using iterator_t = decltype(std::begin(std::declval<Rng &>()));
+template <typename Rng>
+using sentinel_t = decltype(std::end(std::declval<Rng &>()));
+template <typename Rng> using value_t = ranges::iter_value_t<iterator_t<Rng>>;
+
+template <typename Rng, typename = void> constexpr bool has_size = false;
+
+template <typename Rng>
+constexpr bool
+  has_size<Rng, std::void_t<decltype(std::declval<Rng &>().size())>> = true;
+
+template <typename Container, typename = void>
+constexpr bool has_reserve = false;
+
+template <typename Container>
+constexpr bool has_reserve<Container,
+                           std::void_t<decltype(std::declval<Container &>()
+                                                  .reserve(std::size_t{}))>> =
+  true;
+
+template <typename Container, typename = void>
+constexpr bool has_push_back = false;
+
+template <typename Container>
+constexpr bool has_push_back<
+  Container,
+  std::void_t<decltype(std::declval<Container &>().push_back(
+    std::declval<typename Container::value_type>()))>> = true;
+
+// the size of sized ranges, in constant time
+template <typename Rng> constexpr bool is_sized() {
+  return has_size<Rng>
+         || ranges::sized_sentinel_for<sentinel_t<Rng>, iterator_t<Rng>>;
+}
+
+template <typename Rng> std::size_t size(Rng &rng) {
+  if constexpr (has_size<Rng>) {
+    return static_cast<std::size_t>(rng.size());
+  } else {
+    return static_cast<std::size_t>(std::end(rng) - std::begin(rng));
+  }
+}
+
+// a vector allocator for T from an allocator of any type, or from a
+// memory resource
+template <typename T, typename Alloc> auto rebind(const Alloc &alloc) {
+#if __has_include(<memory_resource>)
+  if constexpr (std::is_convertible_v<Alloc, std::pmr::memory_resource *>) {
+    return std::pmr::polymorphic_allocator<T>{alloc};
+  } else
+#endif
+  {
+    return typename std::allocator_traits<Alloc>::template rebind_alloc<T>{
+      alloc};
+  }
+}
+
+template <typename Container, typename Rng>
+void append(Container &container, Rng &rng, size_hint hint) {
+  auto first      = std::begin(rng);
+  const auto last = std::end(rng);
+  using I         = decltype(first);
+  using T         = typename Container::value_type;
+
+  if constexpr (has_reserve<Container>) {
+    if constexpr (is_sized<Rng>()) {
+      container.reserve(container.size() + size(rng));
+    } else if (hint.size != 0) {
+      container.reserve(container.size() + hint.size);
+    }
+  }
+
+  if constexpr (ranges::contiguous_iterator<I>
+                && ranges::sized_sentinel_for<decltype(last), I>
+                && std::is_same_v<ranges::iter_value_t<I>, T>
+                && std::is_trivially_copyable_v<T>) {
+    // with raw pointers, the container copies the elements with memcpy
+    if (first != last) {
+      const auto *data = std::addressof(*first);
+      container.insert(container.end(), data, data + (last - first));
+    }
+  } else {
+    for (; first != last; ++first) {
+      if constexpr (has_push_back<Container>) {
+        container.push_back(*first);
+      } else {
+        container.insert(container.end(), *first);
+      }
+    }
+  }
+}
+} // namespace detail::to_container
+
+// copies the elements of a range into a new container:
+// - sized ranges are reserved for exactly, other ranges by `hint`
+// - trivially copyable elements of contiguous ranges are copied at once
+// - ranges with a sentinel need no views::common
+template <typename Container, typename Rng>
+Container to(Rng &&rng, size_hint hint = {}) {
+  Container container;
+  detail::to_container::append(container, rng, hint);
+  return container;
+}
+
+template <typename Container, typename Rng>
+Container to(Rng &&rng, const typename Container::allocator_type &alloc,
+             size_hint hint = {}) {
+  Container container(alloc);
+  detail::to_container::append(container, rng, hint);
+  return container;
+}
+
+template <typename Rng> auto to_vector(Rng &&rng, size_hint hint = {}) {
+  using T = detail::to_container::value_t<Rng>;
+  return utility::to<std::vector<T>>(rng, hint);
+}
+
+// `alloc` is an allocator, which is rebound to the elements of the range, or
+// a pointer to a std::pmr::memory_resource
+template <typename Rng, typename Alloc>
+auto to_vector(Rng &&rng, const Alloc &alloc, size_hint hint = {}) {
+  using T          = detail::to_container::value_t<Rng>;
+  const auto bound = detail::to_container::rebind<T>(alloc);
+  return utility::to<std::vector<T, std::remove_const_t<decltype(bound)>>>(
+    rng, bound, hint);
+}
+
+} // namespace utility
@@ -0,0 +1,68 @@
+#include <catch2/catch.hpp>
+#include "utility/reduce.hpp"
+#ifdef USE_RANGE_V3
+#include <range/v3/view.hpp>
+#elif defined(USE_NANORANGE)
+#include <nanorange.hpp>
+#else
+#include <experimental/ranges/ranges>
+#endif
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("utility::reduce with a parallel policy") {
+  utility::thread_pool pool{3};
+  const auto par = utility::execution::par.on(pool);
+  const auto seq = utility::execution::seq;
+  // chunks are 1 << 14 elements, up to 256 of them
+  const std::ptrdiff_t chunk = 1 << 14;
+  const std::ptrdiff_t sizes[] = {
+      0, 1, chunk - 1, chunk, chunk + 1,
+      2 * chunk - 1, 2 * chunk + 1, 3 * chunk - 1, 3 * chunk + 1,
+      300 * chunk + 1};
+  for (const auto size : sizes) {
+    std::vector<int> rng(static_cast<std::size_t>(size));
+    std::iota(rng.begin(), rng.end(), 0);
+
+    CAPTURE(size);
+    const auto sum = utility::reduce(par, rng, std::int64_t{0});
+    REQUIRE(sum == utility::reduce(seq, rng, std::int64_t{0}));
+    REQUIRE(sum == std::int64_t{size} * (size - 1) / 2);
+
+    // concatenation is associative but not commutative: partial results
+    // must be combined in order, after `init`
+    const auto letter = [](int i) {
+      return std::string(1, static_cast<char>('a' + i % 26));
+    };
+    const auto text = utility::transform_reduce(par, rng, std::string{">"},
+                                                std::plus<>{}, letter);
+    REQUIRE(text
+            == utility::transform_reduce(seq, rng, std::string{">"},
+                                         std::plus<>{}, letter));
+    REQUIRE(text.size() == static_cast<std::size_t>(size) + 1);
+  }
+}
+
+TEST_CASE("utility::reduce on a pool without workers") {
+  // every task runs on the waiting thread
+  utility::thread_pool pool{0};
+  std::vector<int> rng(5 * (1 << 14) + 3, 1);
+  REQUIRE(utility::reduce(utility::execution::par.on(pool), rng, 0) == 81923);
+}
+
+TEST_CASE("utility::reduce of a view with a parallel policy") {
+  using namespace ranges;
+  utility::thread_pool pool{3};
+  const auto par = utility::execution::par.on(pool);
+  const auto seq = utility::execution::seq;
+  // the squares are computed by the workers, each from its own iterator
+  const int size     = 5 * (1 << 14) + 7;
+  const auto square  = [](int i) { return std::int64_t{i} * i; };
+  const auto squares = views::iota(0, size) | views::transform(square);
+  const auto sum     = utility::reduce(par, squares, std::int64_t{0});
+  REQUIRE(sum == utility::reduce(seq, squares, std::int64_t{0}));
+  REQUIRE(sum == std::int64_t{size - 1} * size * (2 * size - 1) / 6);
+}
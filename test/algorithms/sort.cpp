@@ -0,0 +1,252 @@
+#include <catch2/catch.hpp>
+#include "test/range_matcher.hpp"
+#include "utility/parallel_sort.hpp"
+#include "utility/pdq_sort.hpp"
+#include "utility/powersort.hpp"
+#include "utility/radix_sort.hpp"
+#include "utility/sort.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+// a bidirectional range which is not a container
+template <typename I> struct iterator_range {
+  I begin() const { return first; }
+  I end() const { return last; }
+
+  I first, last;
+};
+
+template <typename I> iterator_range(I, I)->iterator_range<I>;
+} // namespace
+
+TEST_CASE("utility::sort") {
+  SECTION("random access") {
+    std::vector<int> rng{2, 3, 1, 1, 5, 4};
+    utility::sort(rng);
+    check_equal(rng, {1, 1, 2, 3, 4, 5});
+  }
+
+  SECTION("list container") {
+    std::list<int> rng{2, 3, 1, 1, 5, 4};
+    const auto first = &*rng.begin();
+    utility::sort(rng, std::greater<>{});
+    check_equal(rng, {5, 4, 3, 2, 1, 1});
+    // nodes are relinked, not assigned
+    REQUIRE(&*std::next(rng.begin(), 3) == first);
+  }
+
+  SECTION("bidirectional range") {
+    std::list<int> list{9, 2, 3, 1, 1, 5, 4, 0};
+    utility::sort(iterator_range{std::next(list.begin()), std::prev(list.end())});
+    check_equal(list, {9, 1, 1, 2, 3, 4, 5, 0});
+  }
+
+  SECTION("projection") {
+    std::list<std::pair<int, std::string>> rng{{2, "b"}, {1, "c"}, {3, "a"}};
+    utility::sort(rng, {}, &std::pair<int, std::string>::second);
+    check_equal(rng, std::initializer_list<std::pair<int, std::string>>{
+                       {3, "a"}, {2, "b"}, {1, "c"}});
+  }
+}
+
+TEST_CASE("utility::pdq_sort") {
+  std::mt19937 gen;
+  // large enough for block partitioning, with the patterns it detects
+  const int size = 1000;
+  const char *const names[] = {"random", "sorted", "reversed", "few unique",
+                               "organ pipe"};
+  std::vector<std::vector<int>> inputs(std::size(names));
+  for (int i = 0; i != size; ++i) {
+    inputs[0].push_back(static_cast<int>(gen() % size));
+    inputs[1].push_back(i);
+    inputs[2].push_back(size - i);
+    inputs[3].push_back(static_cast<int>(gen() % 4));
+    inputs[4].push_back(std::min(i, size - i));
+  }
+
+  for (std::size_t i = 0; i != inputs.size(); ++i) {
+    const auto &input = inputs[i];
+    auto expected     = input;
+    std::sort(expected.begin(), expected.end());
+
+    DYNAMIC_SECTION("branchless, " << names[i]) {
+      auto rng = input;
+      utility::pdq_sort(rng);
+      REQUIRE(rng == expected);
+    }
+
+    DYNAMIC_SECTION("custom comparator, " << names[i]) {
+      auto rng = input;
+      utility::pdq_sort(rng, [](int lhs, int rhs) { return lhs > rhs; });
+      REQUIRE(std::equal(rng.begin(), rng.end(), expected.rbegin()));
+    }
+  }
+
+  SECTION("projection") {
+    using element = std::pair<int, std::string>;
+    element rng[] = {{2, "b"}, {1, "c"}, {3, "a"}};
+    utility::pdq_sort(rng, std::greater<>{}, &element::first);
+    check_equal(rng, std::initializer_list<element>{
+                       {3, "a"}, {2, "b"}, {1, "c"}});
+  }
+
+  SECTION("proxy references") {
+    // elements are only moved through the proxies, never copied as proxies
+    std::vector<bool> rng;
+    for (int i = 0; i != size; ++i) {
+      rng.push_back(gen() % 3 == 0);
+    }
+    const auto ones = std::count(rng.begin(), rng.end(), true);
+    utility::pdq_sort(rng);
+    REQUIRE(std::is_sorted(rng.begin(), rng.end()));
+    REQUIRE(std::count(rng.begin(), rng.end(), true) == ones);
+    utility::pdq_sort(rng, std::greater<>{});
+    REQUIRE(std::is_sorted(rng.begin(), rng.end(), std::greater<>{}));
+    REQUIRE(std::count(rng.begin(), rng.end(), true) == ones);
+  }
+}
+
+TEST_CASE("utility::radix_sort") {
+  std::mt19937 gen;
+
+  SECTION("signed integers") {
+    std::vector<int> rng;
+    for (int i = 0; i != 1000; ++i) {
+      rng.push_back(static_cast<int>(gen()));
+    }
+    auto expected = rng;
+    std::sort(expected.begin(), expected.end());
+    utility::radix_sort(rng);
+    REQUIRE(rng == expected);
+  }
+
+  SECTION("floating point") {
+    std::vector<double> rng;
+    for (int i = 0; i != 1000; ++i) {
+      rng.push_back(std::uniform_real_distribution<double>{-1e9, 1e9}(gen));
+    }
+    auto expected = rng;
+    std::sort(expected.begin(), expected.end());
+    utility::radix_sort(rng);
+    REQUIRE(rng == expected);
+  }
+
+  SECTION("stable") {
+    std::vector<std::pair<int, int>> rng;
+    for (int i = 0; i != 1000; ++i) {
+      rng.emplace_back(static_cast<int>(gen() % 8) - 4, i);
+    }
+    auto expected = rng;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](auto lhs, auto rhs) { return lhs.first < rhs.first; });
+    utility::radix_sort(rng, &std::pair<int, int>::first);
+    REQUIRE(rng == expected);
+  }
+
+  SECTION("strings") {
+    // shared prefixes, empty strings and prefixes of other keys
+    std::vector<std::string> rng;
+    for (int i = 0; i != 1000; ++i) {
+      rng.push_back(std::string(gen() % 20, 'a') + std::to_string(gen() % 50));
+      if (i % 10 == 0) {
+        rng.emplace_back();
+      }
+    }
+    auto expected = rng;
+    std::sort(expected.begin(), expected.end());
+    utility::radix_sort(rng);
+    REQUIRE(rng == expected);
+  }
+
+  SECTION("projected string") {
+    using element = std::pair<int, std::string>;
+    element rng[] = {{1, "b"}, {2, "ab"}, {3, ""}, {4, "a"}};
+    utility::radix_sort(rng, &element::second);
+    check_equal(rng, std::initializer_list<element>{
+                       {3, ""}, {4, "a"}, {2, "ab"}, {1, "b"}});
+  }
+}
+
+TEST_CASE("utility::sort with a parallel policy") {
+  utility::thread_pool pool{2};
+  const auto policy = utility::execution::par.on(pool);
+  std::mt19937 gen;
+  // large enough not to fall back to a sequential sort
+  std::vector<std::pair<int, int>> rng;
+  for (int i = 0; i != 100000; ++i) {
+    rng.emplace_back(static_cast<int>(gen() % 1000), i);
+  }
+  auto expected = rng;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](auto lhs, auto rhs) { return lhs.first < rhs.first; });
+
+  SECTION("sort") {
+    utility::sort(policy, rng, std::less<>{}, &std::pair<int, int>::first);
+    REQUIRE(std::equal(rng.begin(), rng.end(), expected.begin(),
+                       [](auto lhs, auto rhs) {
+                         return lhs.first == rhs.first;
+                       }));
+  }
+
+  SECTION("stable_sort") {
+    utility::stable_sort(policy, rng, std::less<>{},
+                         &std::pair<int, int>::first);
+    REQUIRE(rng == expected);
+  }
+
+  SECTION("projection taking an lvalue reference") {
+    auto first = [](auto &element) -> auto & { return element.first; };
+    utility::stable_sort(policy, rng, std::less<>{}, first);
+    REQUIRE(rng == expected);
+    std::shuffle(rng.begin(), rng.end(), gen);
+    utility::sort(policy, rng, std::less<>{}, first);
+    REQUIRE(std::is_sorted(rng.begin(), rng.end(), [](auto lhs, auto rhs) {
+      return lhs.first < rhs.first;
+    }));
+  }
+}
+
+TEST_CASE("utility::powersort") {
+  std::mt19937 gen;
+  // runs of every length, ascending and descending, with duplicated keys
+  std::vector<std::pair<int, int>> rng;
+  for (int i = 0; i != 5000; ++i) {
+    const auto run = i / 700;
+    const auto key = run % 2 == 0 ? i : -i;
+    rng.emplace_back(i % 3 == 0 ? static_cast<int>(gen() % 100) : key, i);
+  }
+  auto expected = rng;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](auto lhs, auto rhs) { return lhs.first < rhs.first; });
+
+  SECTION("stable") {
+    utility::powersort(rng, std::less<>{}, &std::pair<int, int>::first);
+    REQUIRE(rng == expected);
+  }
+
+  SECTION("reused scratch") {
+    std::vector<std::pair<int, int>> scratch;
+    auto copy = rng;
+    utility::powersort(copy, scratch, std::less<>{},
+                       &std::pair<int, int>::first);
+    REQUIRE(copy == expected);
+    REQUIRE(scratch.size() <= rng.size() / 2);
+    utility::powersort(rng, scratch, std::less<>{},
+                       &std::pair<int, int>::first);
+    REQUIRE(rng == expected);
+  }
+
+  SECTION("sorted input needs no scratch") {
+    std::vector<std::pair<int, int>> scratch;
+    utility::powersort(expected, scratch, std::less<>{},
+                       &std::pair<int, int>::first);
+    REQUIRE(scratch.empty());
+  }
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+#include "utility/text_stats.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace {
+// one character at a time, by the definitions of text_stats
+utility::text_stats reference_stats(std::string_view text) {
+  utility::text_stats stats;
+  stats.bytes = static_cast<int64_t>(text.size());
+  int64_t line_length = 0;
+  for (std::size_t i = 0; i != text.size(); ++i) {
+    if (!utility::is_space(text[i])
+        && (i == 0 || utility::is_space(text[i - 1]))) {
+      ++stats.words;
+    }
+    if (text[i] == '\n') {
+      ++stats.lines;
+      line_length = 0;
+    } else {
+      stats.max_line_length = std::max(stats.max_line_length, ++line_length);
+    }
+  }
+  return stats;
+}
+
+// the text split at `cuts`, one call per piece
+utility::text_stats
+counted_stats(std::string_view text,
+              std::initializer_list<std::size_t> cuts = {}) {
+  utility::text_stats_counter counter;
+  std::size_t first = 0;
+  for (const auto cut : cuts) {
+    counter(text.data() + first, text.data() + cut);
+    first = cut;
+  }
+  counter(text.data() + first, text.data() + text.size());
+  return counter.result();
+}
+
+void check_stats(const utility::text_stats &actual,
+                 const utility::text_stats &expected) {
+  CHECK(actual.lines == expected.lines);
+  CHECK(actual.words == expected.words);
+  CHECK(actual.bytes == expected.bytes);
+  CHECK(actual.max_line_length == expected.max_line_length);
+}
+} // namespace
+
+TEST_CASE("utility::text_stats_counter") {
+  SECTION("empty") { check_stats(counted_stats(""), {}); }
+
+  SECTION("single line") {
+    check_stats(counted_stats("hello world\n"), {1, 2, 12, 11});
+  }
+
+  SECTION("no trailing newline") {
+    check_stats(counted_stats("one\ntwo three"), {1, 3, 13, 9});
+  }
+
+  SECTION("crlf") {
+    // '\r' is white space, and a byte of the line
+    check_stats(counted_stats("a\r\nbb\r\n"), {2, 2, 7, 3});
+  }
+
+  SECTION("across blocks") {
+    // a word and a line over the first two block boundaries, then a word
+    // which ends the text, after white space
+    std::string text(30, ' ');
+    text += "word";
+    text += std::string(60, 'x') + "\n";
+    text += std::string(5, '\t') + "end";
+    const auto expected = reference_stats(text);
+    check_stats(expected, {1, 2, 103, 94});
+    check_stats(counted_stats(text), expected);
+    for (std::size_t cut = 0; cut <= text.size(); ++cut) {
+      check_stats(counted_stats(text, {cut}), expected);
+    }
+    check_stats(counted_stats(text, {31, 32, 64, 97}), expected);
+  }
+
+  SECTION("random text") {
+    std::mt19937 gen;
+    const std::string_view alphabet = "ab \t\r\n\n";
+    for (const std::size_t size :
+         {1u, 31u, 32u, 33u, 63u, 64u, 65u, 1000u, 4099u}) {
+      std::string text;
+      for (std::size_t i = 0; i != size; ++i) {
+        text.push_back(alphabet[gen() % alphabet.size()]);
+      }
+      const auto expected = reference_stats(text);
+      check_stats(counted_stats(text), expected);
+      const auto a = gen() % (size + 1);
+      const auto b = gen() % (size + 1);
+      check_stats(counted_stats(text, {std::min(a, b), std::max(a, b)}),
+                  expected);
+    }
+  }
+}
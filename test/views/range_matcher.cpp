@@ -0,0 +1,120 @@
+#include "test/range_matcher.hpp"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+// 0, 1, ..., last - 1, read once each. it cannot be copied, so that a check
+// compiles only if it matches the range in place.
+class numbers_input {
+public:
+  struct sentinel {};
+
+  class iterator {
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = int;
+    using difference_type  = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(numbers_input *rng) : m_rng{rng} {}
+
+    int operator*() const { return m_rng->m_next; }
+    iterator &operator++() {
+      ++m_rng->m_next;
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator &it, sentinel) { return it.done(); }
+    friend bool operator==(sentinel s, const iterator &it) { return it == s; }
+    friend bool operator!=(const iterator &it, sentinel s) {
+      return !(it == s);
+    }
+    friend bool operator!=(sentinel s, const iterator &it) {
+      return !(it == s);
+    }
+
+  private:
+    bool done() const { return m_rng->m_next == m_rng->m_last; }
+
+    numbers_input *m_rng = nullptr;
+  };
+
+  explicit numbers_input(int last) : m_last{last} {}
+  numbers_input(const numbers_input &) = delete;
+  numbers_input &operator=(const numbers_input &) = delete;
+
+  iterator begin() { return iterator{this}; }
+  sentinel end() const { return {}; }
+
+  int next() const { return m_next; }
+
+private:
+  int m_next = 0;
+  int m_last;
+};
+
+// the description of a match of `actual` against `expected` which fails
+template <typename LHS, typename RHS>
+std::string description(const LHS &actual, RHS &&expected) {
+  auto matcher = Equals<LHS>(std::forward<RHS>(expected));
+  REQUIRE_FALSE(matcher.match(actual));
+  return matcher.describe();
+}
+} // namespace
+
+TEST_CASE("RangeMatcher") {
+  using Catch::Matchers::Equals;
+  const std::vector<int> numbers{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+  SECTION("equal") {
+    check_equal(numbers, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    check_equal(std::vector<double>{0.1 + 0.2}, {0.3});
+  }
+
+  SECTION("at index") {
+    // three elements of context on both sides
+    CHECK_THAT(description(numbers, std::vector{1, 2, 3, 4, 5, 0, 7, 8, 9, 10}),
+               Equals("not equal\nbecause\n"
+                      "at index 5: 6 != 0\n"
+                      "actual:   { ..., 3, 4, 5, 6, 7, 8, 9, ... }\n"
+                      "expected: { ..., 3, 4, 5, 0, 7, 8, 9, ... }"));
+    CHECK_THAT(description(numbers, std::vector{0, 2, 3}),
+               Equals("not equal\nbecause\n"
+                      "at index 0: 1 != 0\n"
+                      "actual:   { 1, 2, 3, 4, ... }\n"
+                      "expected: { 0, 2, 3 }"));
+  }
+
+  SECTION("of lengths mismatch") {
+    CHECK_THAT(description(numbers, std::vector{1, 2, 3, 4, 5}),
+               Equals("not equal\nbecause\n"
+                      "of lengths mismatch: expected range ends at index 5\n"
+                      "actual:   { ..., 3, 4, 5, 6, 7, 8, 9, ... }\n"
+                      "expected: { ..., 3, 4, 5 }"));
+    CHECK_THAT(description(std::vector{1, 2}, std::vector{1, 2, 3}),
+               Equals("not equal\nbecause\n"
+                      "of lengths mismatch: actual range ends at index 2\n"
+                      "actual:   { 1, 2 }\n"
+                      "expected: { 1, 2, 3 }"));
+  }
+
+  SECTION("input range") {
+    numbers_input input{10};
+    check_equal(input, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    REQUIRE(input.next() == 10);
+
+    // the elements before the difference were read and are gone
+    numbers_input other{10};
+    const auto actual = ranges::ref_view(other);
+    CHECK_THAT(description(actual, std::vector{0, 1, 2, 3, 4, -1, 6}),
+               Equals("not equal\nbecause\n"
+                      "at index 5: 5 != -1\n"
+                      "actual:   { ..., 5, 6, 7, 8, ... }\n"
+                      "expected: { ..., 2, 3, 4, -1, 6 }"));
+  }
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+#include "test/range_matcher.hpp"
+#include "utility/to_container.hpp"
+#ifdef USE_RANGE_V3
+#include <range/v3/view.hpp>
+#endif
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+using namespace ranges;
+
+namespace {
+// counts the allocations made through any of its copies
+template <typename T> struct counting_allocator {
+  using value_type = T;
+
+  counting_allocator(std::size_t &count) : count{&count} {}
+  template <typename U>
+  counting_allocator(const counting_allocator<U> &other) : count{other.count} {}
+
+  T *allocate(std::size_t n) {
+    ++*count;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) { std::allocator<T>{}.deallocate(p, n); }
+
+  template <typename U> bool operator==(const counting_allocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const counting_allocator<U> &) const {
+    return false;
+  }
+
+  std::size_t *count;
+};
+} // namespace
+
+TEST_CASE("utility::to_vector") {
+  auto squares =
+    views::iota(0, 100) | views::transform([](int i) { return i * i; });
+
+  SECTION("sized ranges reserve exactly") {
+    const auto rng = utility::to_vector(squares);
+    REQUIRE(rng.size() == 100);
+    REQUIRE(rng.capacity() == 100);
+    REQUIRE(rng[9] == 81);
+  }
+
+  SECTION("other ranges reserve the hint") {
+    auto even = squares | views::filter([](int i) { return i % 2 == 0; });
+    const auto rng = utility::to_vector(even, utility::size_hint{64});
+    REQUIRE(rng.size() == 50);
+    REQUIRE(rng.capacity() == 64);
+  }
+
+  SECTION("contiguous ranges") {
+    const std::vector<int> ints{1, 2, 3};
+    check_equal(utility::to_vector(ints), {1, 2, 3});
+  }
+
+  SECTION("allocator") {
+    std::size_t count = 0;
+    const auto rng =
+      utility::to_vector(squares, counting_allocator<std::byte>{count});
+    REQUIRE(count == 1);
+    REQUIRE(rng.size() == 100);
+  }
+
+#if __has_include(<memory_resource>)
+  SECTION("memory resource") {
+    std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource resource{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+    const auto rng = utility::to_vector(squares, &resource);
+    REQUIRE(rng.get_allocator().resource() == &resource);
+    REQUIRE(rng.back() == 99 * 99);
+  }
+#endif
+}
+
+TEST_CASE("utility::to") {
+  const std::string text = "hello";
+  REQUIRE(utility::to<std::string>(views::all(text)) == "hello");
+
+  const std::vector<std::pair<int, int>> pairs{{1, 2}, {3, 4}};
+  const auto map = utility::to<std::map<int, int>>(pairs);
+  REQUIRE(map.at(3) == 4);
+}
@@ -1,4 +1,9 @@
 #include "test/range_matcher.hpp"
+#include "utility/c_str.hpp"
+#include "utility/lines.hpp"
+#include "utility/simd_chunk.hpp"
+#include "utility/sort.hpp"
+#include "utility/split.hpp"
 #ifdef USE_RANGE_V3
 #include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/core.hpp>
@@ -7,9 +12,19 @@
 #include <nanorange.hpp>
 #endif
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <locale>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <numeric>
+#include <vector>
 
 #ifdef USE_CMCSTL2
 namespace std::experimental::ranges::v1::view {
@@ -24,6 +39,46 @@ TEST_CASE("all") {
   check_equal(views::all(rng), {1, 2, 3, 4});
 }
 
+TEST_CASE("c_str") {
+  SECTION("literal") {
+    auto &&res = utility::views::c_str("Core C++");
+    REQUIRE(size(res) == 8);
+    check_equal(res, {'C', 'o', 'r', 'e', ' ', 'C', '+', '+'});
+  }
+
+  SECTION("pointer") {
+    const char *str = "hello";
+    auto &&res      = utility::views::c_str(str);
+    static_assert(contiguous_range<decltype(res)>);
+    REQUIRE(size(res) == 5);
+    check_equal(res, {'h', 'e', 'l', 'l', 'o'});
+  }
+
+  SECTION("empty") {
+    const char *str = "";
+    REQUIRE(empty(utility::views::c_str(str)));
+  }
+
+  SECTION("every offset") {
+    // strings start anywhere in an aligned block and span more than the
+    // group of four blocks scanned at once, with characters past their end
+    constexpr std::size_t block = 64;
+    alignas(block) char buffer[8 * block];
+    for (std::size_t offset = 0; offset != block; ++offset) {
+      for (std::size_t length = 0; offset + length < sizeof(buffer);
+           ++length) {
+        std::fill(std::begin(buffer), std::end(buffer), 'x');
+        buffer[offset + length] = '\0';
+        const char *str         = buffer + offset;
+        auto &&res              = utility::views::c_str(str);
+        CAPTURE(offset, length);
+        REQUIRE(size(res) == length);
+        REQUIRE(res.data() == str);
+      }
+    }
+  }
+}
+
 TEST_CASE("commmon") {
   #ifdef USE_RANGE_V3
   auto unreachable_sentinel = unreachable;
@@ -130,6 +185,31 @@ TEST_CASE("join") {
   check_equal(views::join(rng), {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
 }
 
+TEST_CASE("lines") {
+  using namespace std::string_view_literals;
+
+  SECTION("trailing newline") {
+    const std::string text = "One Proposal to\nranges::merge them all,\n";
+    check_equal(utility::views::lines(text),
+                {"One Proposal to"sv, "ranges::merge them all,"sv});
+  }
+
+  SECTION("unterminated last line") {
+    check_equal(utility::views::lines("One\n\nProposal"),
+                {"One"sv, ""sv, "Proposal"sv});
+  }
+
+  SECTION("strip carriage return") {
+    check_equal(utility::views::lines("One\r\nProposal\r\n", true),
+                {"One"sv, "Proposal"sv});
+    // only "\r\n" terminates a line
+    check_equal(utility::views::lines("One\r\nProposal\r", true),
+                {"One"sv, "Proposal\r"sv});
+  }
+
+  SECTION("empty") { REQUIRE(empty(utility::views::lines(""))); }
+}
+
 #ifndef USE_NANORANGE
 TEST_CASE("move") {
   std::vector<std::vector<int>> source{{0, 1, 2}, {3, 4, 5, 6}, {7, 8, 9}};
@@ -158,6 +238,71 @@ TEST_CASE("reverse") {
   check_equal(views::reverse(rng), {6, 5, 4, 3, 2, 1, 0});
 }
 
+#ifdef UTILITY_HAS_STD_SIMD
+TEST_CASE("simd_chunk") {
+  using batch_type    = utility::simd::batch<int>;
+  constexpr int width = static_cast<int>(batch_type::width);
+  // full batches, then a partial one
+  const int count = 3 * width + 1;
+  std::vector<int> rng(static_cast<std::size_t>(count));
+  std::iota(rng.begin(), rng.end(), 1);
+
+  const auto check_batches = [&](auto &&batches) {
+    REQUIRE(batches.size() == 4);
+    int index = 0;
+    for (const batch_type &b : batches) {
+      for (int lane = 0; lane != width; ++lane, ++index) {
+        REQUIRE(b.mask[lane] == (index < count));
+        if (index < count) {
+          REQUIRE(b.values[lane] == index + 1);
+        }
+      }
+    }
+  };
+
+  SECTION("contiguous") { check_batches(utility::views::simd_chunk(rng)); }
+
+  SECTION("random access") {
+    check_batches(utility::views::simd_chunk(views::iota(1, count + 1)));
+  }
+
+  SECTION("owns an rvalue range") {
+    // the iterators of a transform refer to the view, which is a temporary
+    const auto batches = views::iota(0, count)
+                         | views::transform([](int i) { return i + 1; })
+                         | utility::views::simd_chunk;
+    const auto copy = batches;
+    check_batches(batches);
+    check_batches(copy);
+  }
+
+  SECTION("accumulate") {
+    auto squares = utility::views::simd_chunk(rng)
+                   | views::transform([](auto b) { return b * b; });
+    REQUIRE(utility::simd::accumulate(squares, 0)
+            == count * (count + 1) * (2 * count + 1) / 6);
+  }
+
+  SECTION("division") {
+    // the inactive lanes of the partial batch are not divided by. 64 bits
+    // integers are divided one lane at a time, which traps on zero.
+    const std::vector<std::int64_t> wide(rng.begin(), rng.end());
+    using wide_batch = utility::simd::batch<std::int64_t>;
+    for (const wide_batch &b : utility::views::simd_chunk(wide)) {
+      const auto quotients = 1000 / b;
+      const auto ones      = b / b;
+      for (std::size_t lane = 0; lane != wide_batch::width; ++lane) {
+        REQUIRE(quotients.mask[lane] == b.mask[lane]);
+        if (b.mask[lane]) {
+          REQUIRE(quotients.values[lane] == 1000 / b.values[lane]);
+          REQUIRE(ones.values[lane] == 1);
+        }
+      }
+    }
+  }
+}
+#endif
+
 TEST_CASE("single") { check_equal(views::single(42), {42}); }
 
 TEST_CASE("split") {
@@ -211,6 +356,73 @@ TEST_CASE("split") {
   }
 }
 
+// whether `text | utility::views::split(' ')` compiles for a `Text`
+template <typename Text, typename = void>
+constexpr bool pipes_into_split = false;
+
+template <typename Text>
+constexpr bool pipes_into_split<
+  Text,
+  std::void_t<decltype(std::declval<Text>() | utility::views::split(' '))>> =
+  true;
+
+TEST_CASE("utility::views::split") {
+  using namespace std::string_view_literals;
+  const std::string str =
+    "One Proposal to ranges::merge them all, One Proposal to ranges::find them";
+
+  SECTION("by char") {
+    check_equal(utility::views::split("One  Proposal ", ' '),
+                {"One"sv, ""sv, "Proposal"sv, ""sv});
+  }
+
+  SECTION("by string") {
+    check_equal(str | utility::views::split("ranges::"),
+                {"One Proposal to "sv, "merge them all, One Proposal to "sv,
+                 "find them"sv});
+  }
+
+  SECTION("by any of") {
+    check_equal(utility::views::split(str, utility::any_of{":,"}),
+                {"One Proposal to ranges"sv, ""sv, "merge them all"sv,
+                 " One Proposal to ranges"sv, ""sv, "find them"sv});
+  }
+
+  SECTION("empty") { REQUIRE(empty(utility::views::split("", ' '))); }
+
+  SECTION("string across blocks") {
+    // the delimiter at every position of a text spanning several blocks,
+    // straddling each block boundary
+    const std::string text(200, 'x');
+    for (std::size_t position = 0; position + 3 <= text.size(); ++position) {
+      auto delimited = text;
+      delimited.replace(position, 3, "<->");
+      CAPTURE(position);
+      check_equal(utility::views::split(delimited, "<->"),
+                  {std::string_view{text}.substr(0, position),
+                   std::string_view{text}.substr(position + 3)});
+    }
+  }
+
+  SECTION("empty string") {
+    REQUIRE_THROWS_AS(utility::views::split(str, ""), std::invalid_argument);
+    REQUIRE_THROWS_AS(str | utility::views::split(""sv),
+                      std::invalid_argument);
+  }
+
+  SECTION("temporary text") {
+    // the pieces would outlive a temporary string, a string view is fine
+    using split_fn = decltype(utility::views::split);
+    static_assert(!std::is_invocable_v<split_fn, std::string, char>);
+    static_assert(std::is_invocable_v<split_fn, const std::string &, char>);
+    static_assert(std::is_invocable_v<split_fn, std::string_view, char>);
+    static_assert(!pipes_into_split<std::string>);
+    static_assert(!pipes_into_split<std::vector<char>>);
+    static_assert(pipes_into_split<const std::string &>);
+    static_assert(pipes_into_split<std::string_view>);
+  }
+}
+
 TEST_CASE("subrange") {
   const int rng[] = {1, 2, 3, 4};
 
@@ -262,3 +474,53 @@ TEST_CASE("transform") {
                 {"0"s, "1"s, "2"s, "3"s, "4"s, "5"s});
   }
 }
+
+TEST_CASE("zip") {
+  std::vector<int> numbers{1, 2, 3, 4};
+  const int offsets[] = {10, 20, 30};
+
+  SECTION("shortest range") {
+    auto &&res = views::zip(numbers, offsets);
+    REQUIRE(size(res) == 3);
+    REQUIRE(end(res) - begin(res) == 3);
+    REQUIRE((*next(begin(res), 2)).second == 30);
+  }
+
+  SECTION("writes through") {
+    for (auto &&[number, offset] : views::zip(numbers, offsets)) {
+      number += offset;
+    }
+    check_equal(numbers, {11, 22, 33, 4});
+  }
+
+  SECTION("infinite range") {
+    auto &&res = views::zip(numbers, views::iota(0));
+    REQUIRE(distance(res) == 4);
+    for (auto &&[number, index] : res) {
+      REQUIRE(number == index + 1);
+    }
+  }
+
+  SECTION("zip_with") {
+    check_equal(views::zip_with(std::plus<>{}, numbers, offsets),
+                {11, 22, 33});
+  }
+
+  SECTION("random access") {
+    std::vector<char> names{'d', 'c', 'b', 'a'};
+    using zipped = decltype(views::zip(numbers, names));
+    static_assert(random_access_range<zipped>);
+    static_assert(sized_range<zipped>);
+    static_assert(common_range<zipped>);
+  }
+
+  SECTION("sort") {
+    // the elements move in both ranges, through the references of the zip
+    std::vector<int> keys{4, 1, 3, 5, 2};
+    std::vector<char> values{'d', 'a', 'c', 'e', 'b'};
+    utility::sort(views::zip(keys, values), std::greater<>{},
+                  [](const auto &pair) { return pair.first; });
+    check_equal(keys, {5, 4, 3, 2, 1});
+    check_equal(values, {'e', 'd', 'c', 'b', 'a'});
+  }
+}